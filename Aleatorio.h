@@ -0,0 +1,67 @@
+#ifndef ACO_LABIRINTO_ALEATORIO_H
+#define ACO_LABIRINTO_ALEATORIO_H
+
+#include <cstdint>
+#include <limits>
+
+// splitmix64: embaralha um inteiro de 64 bits. Serve para espalhar sementes parecidas (0, 1, 2...) em estados
+// bem diferentes, e é o jeito recomendado de inicializar o xoshiro
+inline std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Gerador xoshiro256** (estado de 32 bytes, bem mais leve que o mt19937, que tem ~2.5KB).
+// Segue a interface de UniformRandomBitGenerator, então funciona com as distribuições da <random>
+class GeradorAleatorio {
+public:
+    using result_type = std::uint64_t;
+
+    explicit GeradorAleatorio(std::uint64_t semente = 0) { semear(semente); }
+
+    void semear(std::uint64_t semente) {
+        for (std::uint64_t& s : estado) s = splitmix64(semente);
+    }
+
+    // Fluxo "baseado em contador": o estado depende só de (semente mestre, id, contador), então a formiga i na
+    // iteração t sempre recebe a mesma sequência, não importa em qual thread ou em que ordem ela rode
+    static GeradorAleatorio para_fluxo(std::uint64_t semente_mestre, std::uint64_t id, std::uint64_t contador) {
+        std::uint64_t a = id, b = contador ^ 0xD1B54A32D192ED03ull;
+        return GeradorAleatorio(semente_mestre ^ splitmix64(a) ^ (splitmix64(b) << 1));
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t resultado = rotl(estado[1] * 5, 7) * 9;
+        const std::uint64_t t = estado[1] << 17;
+        estado[2] ^= estado[0];
+        estado[3] ^= estado[1];
+        estado[1] ^= estado[2];
+        estado[0] ^= estado[3];
+        estado[2] ^= t;
+        estado[3] = rotl(estado[3], 45);
+        return resultado;
+    }
+
+    // double uniforme em [0, 1), usando os 53 bits mais altos
+    double uniforme() {
+        return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
+    }
+
+    // As 4 palavras do estado, para quem roda o mesmo gerador em outro formato (LoteFormigas guarda em SoA)
+    [[nodiscard]] std::uint64_t get_estado(const int i) const { return estado[i]; }
+
+private:
+    static std::uint64_t rotl(const std::uint64_t x, const int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t estado[4]{};
+};
+
+
+#endif //ACO_LABIRINTO_ALEATORIO_H
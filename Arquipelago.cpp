@@ -0,0 +1,210 @@
+#include "Arquipelago.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "Aleatorio.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+template<class ColoniaT>
+Arquipelago<ColoniaT>::Arquipelago(const Labirinto &base, const ConfigColonia &config,
+                                   const ConfigIlhas &config_ilhas)
+    :   config_ilhas(config_ilhas)
+{
+    if (config_ilhas.n_ilhas < 1) {
+        throw std::runtime_error("O arquipelago precisa de pelo menos 1 ilha!");
+    }
+    if (config_ilhas.intervalo_migracao < 1) {
+        throw std::runtime_error("O intervalo de migracao precisa ser maior que 0!");
+    }
+
+    for (int i=0; i<config_ilhas.n_ilhas; i++) {
+        ConfigColonia config_ilha = config;
+        std::uint64_t semente = config.semente + static_cast<std::uint64_t>(i);
+        config_ilha.semente = splitmix64(semente);
+
+        labirintos.push_back(std::make_unique<Labirinto>(base));
+        colonias.push_back(std::make_unique<ColoniaT>(*labirintos.back(), config_ilha));
+    }
+    caminhos_publicados.resize(config_ilhas.n_ilhas);
+    if (config_ilhas.migracao == MigracaoIlhas::MISTURA_FEROMONIO) {
+        const size_t n_celulas = static_cast<size_t>(base.get_largura()) * base.get_altura();
+        campos_publicados.assign(config_ilhas.n_ilhas, std::vector<float>(n_celulas));
+    }
+}
+
+template<class ColoniaT>
+std::vector<int> Arquipelago<ColoniaT>::vizinhas(const int ilha) const {
+    const int n = config_ilhas.n_ilhas;
+    if (n == 1) return {};
+    if (config_ilhas.topologia == TopologiaIlhas::ANEL) return {(ilha + n - 1) % n};
+
+    std::vector<int> todas;
+    for (int i=0; i<n; i++) {
+        if (i != ilha) todas.push_back(i);
+    }
+    return todas;
+}
+
+template<class ColoniaT>
+ResultadoArquipelago Arquipelago<ColoniaT>::executar(const int n_iteracoes) {
+    const int n = config_ilhas.n_ilhas;
+#ifdef _OPENMP
+    const int threads_omp = std::max(1, omp_get_max_threads() / n);
+#else
+    const int threads_omp = 1;
+#endif
+
+    std::barrier<> barreira(n);
+    std::vector<std::exception_ptr> erros(n);
+    std::atomic<bool> abortar = false;
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+    for (int i=0; i<n; i++) {
+        threads.emplace_back(&Arquipelago::rodar_ilha, this, i, n_iteracoes, threads_omp, std::ref(barreira),
+                             std::ref(erros), std::ref(abortar));
+    }
+    for (std::thread& t : threads) t.join();
+    // exceção não pode sair da thread da ilha (seria std::terminate), então ela é jogada aqui
+    for (const std::exception_ptr& erro : erros) {
+        if (erro) std::rethrow_exception(erro);
+    }
+
+    ResultadoArquipelago resultado;
+    resultado.iteracoes = iteracoes_feitas;
+    for (int i=0; i<n; i++) {
+        const int melhor = colonias[i]->get_menor_tamanho_global();
+        resultado.melhor_por_ilha.push_back(melhor);
+        if (melhor != -1 && (resultado.melhor_geral == -1 || melhor < resultado.melhor_geral)) {
+            resultado.melhor_geral = melhor;
+            resultado.ilha_do_melhor = i;
+        }
+    }
+    if (resultado.ilha_do_melhor != -1) {
+        melhor_caminho = colonias[resultado.ilha_do_melhor]->get_melhor_caminho_global();
+    }
+    return resultado;
+}
+
+template<class ColoniaT>
+void Arquipelago<ColoniaT>::rodar_ilha(const int ilha, const int n_iteracoes, const int threads_omp,
+                                       std::barrier<>& barreira, std::vector<std::exception_ptr>& erros,
+                                       std::atomic<bool>& abortar) {
+#ifdef __linux__
+    if (config_ilhas.fixar_threads) {
+        // núcleos [ilha*por_ilha, (ilha+1)*por_ilha), dando a volta se tiver mais ilhas que núcleos. Fixado aqui,
+        // antes da primeira região paralela, para o time do OpenMP que a ilha cria já nascer com esse conjunto
+        const int nucleos = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        const int por_ilha = std::max(1, nucleos / config_ilhas.n_ilhas);
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        for (int c=0; c<por_ilha; c++) CPU_SET((ilha * por_ilha + c) % nucleos, &conjunto);
+        pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto);
+    }
+#endif
+#ifdef _OPENMP
+    omp_set_num_threads(threads_omp); // vale só para esta thread
+#else
+    (void) threads_omp;
+#endif
+    try {
+        ColoniaT& colonia = *colonias[ilha];
+        Labirinto& lab = *labirintos[ilha];
+        const std::vector<int> origens = vizinhas(ilha);
+        const bool misturar = config_ilhas.migracao == MigracaoIlhas::MISTURA_FEROMONIO && !origens.empty();
+        std::vector<float> media;
+        if (misturar) media.resize(campos_publicados[ilha].size());
+
+        // toda ilha calcula a estagnação com os mesmos dados publicados, então todas decidem parar juntas
+        int melhor_visto = -1, ultima_melhora = 0;
+
+        int it = 0;
+        while (it < n_iteracoes && !abortar.load(std::memory_order_relaxed)) {
+            colonia.iterar();
+            it++;
+            if (it % config_ilhas.intervalo_migracao != 0 || it == n_iteracoes) continue;
+
+            caminhos_publicados[ilha] = colonia.get_melhor_caminho_global();
+            if (misturar) lab.copiar_feromonios(campos_publicados[ilha].data());
+            barreira.arrive_and_wait();
+
+            int melhor_geral = -1;
+            for (const CaminhoCompacto& caminho : caminhos_publicados) {
+                const int tamanho = static_cast<int>(caminho.size());
+                if (tamanho > 0 && (melhor_geral == -1 || tamanho < melhor_geral)) melhor_geral = tamanho;
+            }
+            if (melhor_geral != -1 && (melhor_visto == -1 || melhor_geral < melhor_visto)) {
+                melhor_visto = melhor_geral;
+                ultima_melhora = it;
+            }
+
+            // o menor caminho entre as vizinhas, empate fica com a de menor número
+            const CaminhoCompacto* recebido = nullptr;
+            for (const int origem : origens) {
+                const CaminhoCompacto& caminho = caminhos_publicados[origem];
+                if (!caminho.empty() && (!recebido || caminho.size() < recebido->size())) recebido = &caminho;
+            }
+            if (recebido) colonia.importar_caminho(*recebido);
+
+            if (misturar) {
+                std::fill(media.begin(), media.end(), 0.0f);
+                const float fracao = 1.0f / static_cast<float>(origens.size());
+                for (const int origem : origens) {
+                    const std::vector<float>& campo = campos_publicados[origem];
+                    for (size_t c=0; c<media.size(); c++) media[c] += campo[c] * fracao;
+                }
+                lab.misturar_campo(media, config_ilhas.peso_mistura);
+            }
+
+            // segunda barreira: ninguém pode publicar de novo enquanto alguma ilha ainda está lendo
+            barreira.arrive_and_wait();
+
+            if (config_ilhas.parada_por_estagnacao != -1 && melhor_visto != -1
+                && it - ultima_melhora >= config_ilhas.parada_por_estagnacao) {
+                break;
+            }
+        }
+        if (ilha == 0) iteracoes_feitas = it;
+    } catch (...) {
+        erros[ilha] = std::current_exception();
+        abortar.store(true, std::memory_order_relaxed);
+    }
+    // saindo por qualquer motivo: as ilhas que ainda estão rodando param de esperar esta nas barreiras
+    barreira.arrive_and_drop();
+}
+
+// Getters
+
+template<class ColoniaT>
+int Arquipelago<ColoniaT>::get_n_ilhas() const {
+    return config_ilhas.n_ilhas;
+}
+
+template<class ColoniaT>
+const ColoniaT& Arquipelago<ColoniaT>::get_colonia(const int ilha) const {
+    return *colonias[ilha];
+}
+
+template<class ColoniaT>
+const Labirinto& Arquipelago<ColoniaT>::get_labirinto(const int ilha) const {
+    return *labirintos[ilha];
+}
+
+template<class ColoniaT>
+const CaminhoCompacto& Arquipelago<ColoniaT>::get_melhor_caminho() const {
+    return melhor_caminho;
+}
+
+// As mesmas variantes do Colonia.cpp
+template class Arquipelago<Colonia>;
+template class Arquipelago<ColoniaMMAS>;
+template class Arquipelago<ColoniaACS>;
+template class Arquipelago<ColoniaRank>;
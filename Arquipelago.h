@@ -0,0 +1,76 @@
+#ifndef ACO_LABIRINTO_ARQUIPELAGO_H
+#define ACO_LABIRINTO_ARQUIPELAGO_H
+
+#include <atomic>
+#include <barrier>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "CaminhoCompacto.h"
+#include "Colonia.h"
+#include "Labirinto.h"
+
+// ANEL: a ilha i só recebe da i-1. COMPLETA: recebe de todas as outras
+enum class TopologiaIlhas { ANEL, COMPLETA };
+// MELHOR_CAMINHO: a ilha importa o menor caminho das vizinhas (Colonia::importar_caminho), se for melhor que o dela.
+// MISTURA_FEROMONIO: além disso, mistura o campo de feromônio dela com a média dos campos das vizinhas
+enum class MigracaoIlhas { MELHOR_CAMINHO, MISTURA_FEROMONIO };
+
+struct ConfigIlhas {
+    int n_ilhas = 4;
+    int intervalo_migracao = 10; // de quantas em quantas iterações as ilhas trocam informação
+    TopologiaIlhas topologia = TopologiaIlhas::ANEL;
+    MigracaoIlhas migracao = MigracaoIlhas::MELHOR_CAMINHO;
+    double peso_mistura = 0.1; // quanto do campo das vizinhas entra no MISTURA_FEROMONIO
+    // iterações sem o melhor geral melhorar para parar todas as ilhas (-1 desativa). Só é conferido nas migrações,
+    // que é quando as ilhas sabem do resultado das outras
+    int parada_por_estagnacao = -1;
+    bool fixar_threads = true; // no Linux, prende cada ilha num grupo separado de núcleos
+};
+
+struct ResultadoArquipelago {
+    std::vector<int> melhor_por_ilha; // -1 = a ilha não achou caminho
+    int melhor_geral = -1;
+    int ilha_do_melhor = -1;
+    int iteracoes = 0; // iterações feitas por cada ilha (todas fazem o mesmo número)
+};
+
+// Modelo de ilhas: n_ilhas colônias independentes, cada uma com a sua cópia do Labirinto (o feromônio é separado,
+// as paredes são compartilhadas) e rodando na sua própria thread. As threads do OpenMP são divididas entre as ilhas.
+// Nas migrações todas esperam numa barreira, então o resultado não depende da velocidade de cada thread: com a
+// mesma semente, sai o mesmo resultado
+template<class ColoniaT>
+class Arquipelago {
+public:
+    // Cada ilha usa o config com uma semente derivada de config.semente e do número da ilha
+    Arquipelago(const Labirinto& base, const ConfigColonia& config, const ConfigIlhas& config_ilhas);
+
+    ResultadoArquipelago executar(int n_iteracoes);
+
+    [[nodiscard]] int get_n_ilhas() const;
+    [[nodiscard]] const ColoniaT& get_colonia(int ilha) const;
+    [[nodiscard]] const Labirinto& get_labirinto(int ilha) const;
+    [[nodiscard]] const CaminhoCompacto& get_melhor_caminho() const; // melhor entre todas as ilhas
+
+private:
+    ConfigIlhas config_ilhas;
+    // unique_ptr porque a colônia guarda referência para o labirinto da ilha e não pode ser movida
+    std::vector<std::unique_ptr<Labirinto>> labirintos;
+    std::vector<std::unique_ptr<ColoniaT>> colonias;
+
+    // Área de troca: antes da barreira cada ilha só escreve na sua posição, depois dela só lê das vizinhas
+    std::vector<CaminhoCompacto> caminhos_publicados;
+    std::vector<std::vector<float>> campos_publicados;
+
+    CaminhoCompacto melhor_caminho;
+    int iteracoes_feitas = 0;
+
+    // Exceção numa ilha fica em erros[ilha] e liga abortar, as outras param na próxima iteração
+    void rodar_ilha(int ilha, int n_iteracoes, int threads_omp, std::barrier<>& barreira,
+                    std::vector<std::exception_ptr>& erros, std::atomic<bool>& abortar);
+    [[nodiscard]] std::vector<int> vizinhas(int ilha) const;
+};
+
+
+#endif //ACO_LABIRINTO_ARQUIPELAGO_H
@@ -0,0 +1,146 @@
+#include "ArquivoLabirinto.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static std::uint64_t palavras_para(const std::uint64_t n_celulas) {
+    return (n_celulas + 63) / 64;
+}
+
+// Confere o cabeçalho contra o tamanho do arquivo e devolve o ArquivoLabirinto sem as paredes
+static ArquivoLabirinto validar(const CabecalhoLabirinto& cabecalho, const std::uint64_t tamanho_arquivo,
+                                const std::string& caminho) {
+    if (std::memcmp(cabecalho.magico, MAGICO_LABIRINTO, sizeof(MAGICO_LABIRINTO)) != 0) {
+        throw std::runtime_error(caminho + " nao e um arquivo de labirinto");
+    }
+    if (cabecalho.versao != VERSAO_LABIRINTO) {
+        throw std::runtime_error(caminho + ": versao " + std::to_string(cabecalho.versao) + " nao suportada");
+    }
+    if (cabecalho.bits_por_celula != 1) throw std::runtime_error(caminho + ": bits_por_celula invalido");
+
+    const std::uint64_t n_celulas = static_cast<std::uint64_t>(cabecalho.largura) * cabecalho.altura;
+    // o Labirinto indexa com int (x*altura + y)
+    if (n_celulas == 0 || n_celulas > static_cast<std::uint64_t>(INT_MAX)) {
+        throw std::runtime_error(caminho + ": tamanho invalido");
+    }
+    if (cabecalho.n_palavras != palavras_para(n_celulas) || cabecalho.offset_paredes % 8 != 0
+        || cabecalho.offset_paredes < sizeof(CabecalhoLabirinto)
+        // sem somar com o offset, que vem do arquivo e poderia dar a volta
+        || cabecalho.offset_paredes > tamanho_arquivo
+        || cabecalho.n_palavras * 8 > tamanho_arquivo - cabecalho.offset_paredes) {
+        throw std::runtime_error(caminho + ": arquivo truncado ou cabecalho inconsistente");
+    }
+
+    ArquivoLabirinto arquivo;
+    arquivo.largura = static_cast<int>(cabecalho.largura);
+    arquivo.altura = static_cast<int>(cabecalho.altura);
+    arquivo.pos_ninho = {cabecalho.ninho_x, cabecalho.ninho_y};
+    arquivo.pos_comida = {cabecalho.comida_x, cabecalho.comida_y};
+    for (const Pos& p : {arquivo.pos_ninho, arquivo.pos_comida}) {
+        if (p.x < 0 || p.x >= arquivo.largura || p.y < 0 || p.y >= arquivo.altura) {
+            throw std::runtime_error(caminho + ": ninho ou comida fora do labirinto");
+        }
+    }
+    return arquivo;
+}
+
+static bool eh_parede(const std::uint64_t* paredes, const ArquivoLabirinto& arquivo, const Pos& p) {
+    const std::uint64_t i = static_cast<std::uint64_t>(p.x) * arquivo.altura + p.y;
+    return (paredes[i / 64] >> (i % 64)) & 1;
+}
+
+#ifndef _WIN32
+// Dono do mapeamento, o shared_ptr das paredes aponta para dentro dele
+struct Mapeamento {
+    void* inicio = nullptr;
+    size_t tamanho = 0;
+    ~Mapeamento() {
+        if (inicio) munmap(inicio, tamanho);
+    }
+};
+#endif
+
+ArquivoLabirinto mapear_arquivo_labirinto(const std::string &caminho) {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("O arquivo de labirinto e little-endian, esta maquina nao");
+    }
+
+#ifndef _WIN32
+    const int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Nao foi possivel abrir o labirinto " + caminho);
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(CabecalhoLabirinto)) {
+        close(fd);
+        throw std::runtime_error(caminho + " nao e um arquivo de labirinto");
+    }
+    auto mapeamento = std::make_shared<Mapeamento>();
+    mapeamento->tamanho = static_cast<size_t>(info.st_size);
+    void* inicio = mmap(nullptr, mapeamento->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // o mapeamento continua valendo sem o descritor
+    if (inicio == MAP_FAILED) throw std::runtime_error("Nao foi possivel mapear o labirinto " + caminho);
+    mapeamento->inicio = inicio;
+
+    CabecalhoLabirinto cabecalho{};
+    std::memcpy(&cabecalho, inicio, sizeof(cabecalho));
+    ArquivoLabirinto arquivo = validar(cabecalho, mapeamento->tamanho, caminho);
+    const auto* palavras = reinterpret_cast<const std::uint64_t*>(
+        static_cast<const char*>(inicio) + cabecalho.offset_paredes);
+    arquivo.paredes = std::shared_ptr<const std::uint64_t>(mapeamento, palavras);
+#else
+    std::ifstream entrada(caminho, std::ios::binary | std::ios::ate);
+    if (!entrada.is_open()) throw std::runtime_error("Nao foi possivel abrir o labirinto " + caminho);
+    const auto tamanho = static_cast<std::uint64_t>(entrada.tellg());
+    CabecalhoLabirinto cabecalho{};
+    entrada.seekg(0);
+    if (!entrada.read(reinterpret_cast<char*>(&cabecalho), sizeof(cabecalho))) {
+        throw std::runtime_error(caminho + " nao e um arquivo de labirinto");
+    }
+    ArquivoLabirinto arquivo = validar(cabecalho, tamanho, caminho);
+    auto palavras = std::make_shared<std::vector<std::uint64_t>>(cabecalho.n_palavras);
+    entrada.seekg(static_cast<std::streamoff>(cabecalho.offset_paredes));
+    entrada.read(reinterpret_cast<char*>(palavras->data()),
+                 static_cast<std::streamsize>(cabecalho.n_palavras * sizeof(std::uint64_t)));
+    arquivo.paredes = std::shared_ptr<const std::uint64_t>(palavras, palavras->data());
+#endif
+
+    if (eh_parede(arquivo.paredes.get(), arquivo, arquivo.pos_ninho)
+        || eh_parede(arquivo.paredes.get(), arquivo, arquivo.pos_comida)) {
+        throw std::runtime_error(caminho + ": ninho ou comida em cima de uma parede");
+    }
+    return arquivo;
+}
+
+void escrever_arquivo_labirinto(const std::string &caminho, const int largura, const int altura,
+                                const Pos &pos_ninho, const Pos &pos_comida, const std::uint64_t *paredes) {
+    std::ofstream saida(caminho, std::ios::binary);
+    if (!saida.is_open()) throw std::runtime_error("Nao foi possivel criar o arquivo " + caminho);
+
+    CabecalhoLabirinto cabecalho{};
+    std::copy(std::begin(MAGICO_LABIRINTO), std::end(MAGICO_LABIRINTO), cabecalho.magico);
+    cabecalho.versao = VERSAO_LABIRINTO;
+    cabecalho.largura = static_cast<std::uint32_t>(largura);
+    cabecalho.altura = static_cast<std::uint32_t>(altura);
+    cabecalho.ninho_x = pos_ninho.x;
+    cabecalho.ninho_y = pos_ninho.y;
+    cabecalho.comida_x = pos_comida.x;
+    cabecalho.comida_y = pos_comida.y;
+    cabecalho.bits_por_celula = 1;
+    cabecalho.offset_paredes = sizeof(CabecalhoLabirinto);
+    cabecalho.n_palavras = palavras_para(static_cast<std::uint64_t>(largura) * altura);
+
+    saida.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+    saida.write(reinterpret_cast<const char*>(paredes),
+                static_cast<std::streamsize>(cabecalho.n_palavras * sizeof(std::uint64_t)));
+    if (!saida) throw std::runtime_error("Erro escrevendo o arquivo " + caminho);
+}
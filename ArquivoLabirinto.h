@@ -0,0 +1,47 @@
+#ifndef ACO_LABIRINTO_ARQUIVOLABIRINTO_H
+#define ACO_LABIRINTO_ARQUIVOLABIRINTO_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Labirinto.h"
+
+// Formato binário do labirinto (little-endian), para não gerar de novo os labirintos que são usados sempre:
+//   CabecalhoLabirinto (64 bytes)
+//   zeros até offset_paredes (múltiplo de 8)
+//   n_palavras uint64 com as paredes: bit (i % 64) da palavra i/64 = célula i é parede, na ordem do Labirinto
+//   (x*altura + y). Os bits depois da última célula são zero
+// Ninho e comida ficam só no cabeçalho. As paredes já estão no formato que o Labirinto usa na memória, então
+// carregar é só um mmap: nada é lido do disco até alguma formiga passar pela região, e as páginas são do cache do
+// sistema (vários processos com o mesmo arquivo dividem a mesma memória)
+constexpr char MAGICO_LABIRINTO[8] = {'A', 'C', 'O', 'L', 'A', 'B', '\0', '\0'};
+constexpr std::uint32_t VERSAO_LABIRINTO = 1;
+
+struct CabecalhoLabirinto {
+    char magico[8];
+    std::uint32_t versao;
+    std::uint32_t largura, altura;
+    std::int32_t ninho_x, ninho_y, comida_x, comida_y;
+    std::uint32_t bits_por_celula; // 1 (só parede ou não, único por enquanto)
+    std::uint64_t offset_paredes;
+    std::uint64_t n_palavras;
+    std::uint8_t reservado[8];
+};
+static_assert(sizeof(CabecalhoLabirinto) == 64);
+
+// O que sai do arquivo. paredes fica válido enquanto alguma cópia do shared_ptr existir (o munmap é no último)
+struct ArquivoLabirinto {
+    int largura = 0, altura = 0;
+    Pos pos_ninho{}, pos_comida{};
+    std::shared_ptr<const std::uint64_t> paredes;
+};
+
+// Mapeia o arquivo só para leitura e confere o cabeçalho (mágico, versão, tamanhos, posições dentro do labirinto e
+// fora das paredes). Qualquer problema dá runtime_error. Sem mmap (Windows) lê as paredes para a memória
+[[nodiscard]] ArquivoLabirinto mapear_arquivo_labirinto(const std::string& caminho);
+void escrever_arquivo_labirinto(const std::string& caminho, int largura, int altura, const Pos& pos_ninho,
+                                const Pos& pos_comida, const std::uint64_t* paredes);
+
+
+#endif //ACO_LABIRINTO_ARQUIVOLABIRINTO_H
@@ -0,0 +1,17 @@
+#include "CaminhoCompacto.h"
+
+void CaminhoCompacto::codificar(const std::vector<Pos> &caminho) {
+    if (caminho.empty()) {
+        clear();
+        return;
+    }
+    reiniciar(caminho.front());
+    palavras.reserve((caminho.size() - 1 + PASSOS_POR_PALAVRA - 1) / PASSOS_POR_PALAVRA);
+    for (size_t i=1; i<caminho.size(); i++) push_back(caminho[i]);
+}
+
+void CaminhoCompacto::decodificar(std::vector<Pos> &destino) const {
+    destino.clear();
+    destino.reserve(size());
+    for (const Pos& p : *this) destino.push_back(p);
+}
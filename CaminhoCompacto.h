@@ -0,0 +1,159 @@
+#ifndef ACO_LABIRINTO_CAMINHOCOMPACTO_H
+#define ACO_LABIRINTO_CAMINHOCOMPACTO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "Labirinto.h"
+#include "Serializacao.h"
+
+// Caminho guardado como a célula de início + um código de 2 bits por passo (32 passos por palavra de 64 bits), em
+// vez de um Pos (8 bytes) por célula. Como o caminho só anda entre vizinhas, o passo é uma das 4 direções:
+//   0 = x-1, 1 = x+1, 2 = y-1, 3 = y+1 (a mesma ordem do Formiga::get_caminhos_validos)
+// e a direção contrária é só o código com o último bit trocado (codigo ^ 1), o que deixa o pop_back O(1).
+// As palavras que sobram depois do último passo ficam zeradas e o vetor tem sempre o tamanho exato, então copiar
+// (a cópia padrão) só copia os passos que existem, e o == compara direto as palavras.
+// Ler as células é com o Iterador (for (const Pos& p : caminho)), que vai decodificando a partir do início
+class CaminhoCompacto {
+public:
+    class Iterador {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Pos;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Pos*;
+        using reference = Pos;
+
+        Iterador() = default;
+        Iterador(const std::uint64_t* palavras, const std::size_t n_passos, const Pos inicio, const std::size_t celula)
+            : palavras(palavras), n_passos(n_passos), atual(inicio), celula(celula) {}
+
+        Pos operator*() const { return atual; }
+        const Pos* operator->() const { return &atual; }
+        Iterador& operator++() {
+            if (celula < n_passos) atual = CaminhoCompacto::andar(atual, CaminhoCompacto::ler(palavras, celula));
+            celula++;
+            return *this;
+        }
+        Iterador operator++(int) {
+            Iterador antes = *this;
+            ++*this;
+            return antes;
+        }
+        bool operator==(const Iterador& outro) const { return celula == outro.celula; }
+        bool operator!=(const Iterador& outro) const { return celula != outro.celula; }
+
+    private:
+        const std::uint64_t* palavras = nullptr;
+        std::size_t n_passos = 0;
+        Pos atual{};
+        std::size_t celula = 0;
+    };
+
+    CaminhoCompacto() = default;
+
+    // Esvazia e começa um caminho novo em inicio (reaproveita a capacidade)
+    void reiniciar(const Pos& inicio) {
+        this->inicio = inicio;
+        this->fim = inicio;
+        n_passos = 0;
+        vazio = false;
+        palavras.clear();
+    }
+    void clear() {
+        n_passos = 0;
+        vazio = true;
+        palavras.clear();
+    }
+
+    // p tem que ser vizinha de back() (ou o início, se o caminho estiver vazio)
+    void push_back(const Pos& p) {
+        if (vazio) {
+            reiniciar(p);
+            return;
+        }
+        const int dx = p.x - fim.x;
+        const std::uint64_t codigo = dx != 0 ? (dx > 0) : 2 + (p.y > fim.y);
+        const std::size_t deslocamento = (n_passos % PASSOS_POR_PALAVRA) * 2;
+        if (deslocamento == 0) palavras.push_back(codigo);
+        else palavras.back() |= codigo << deslocamento;
+        n_passos++;
+        fim = p;
+    }
+    void pop_back() {
+        if (n_passos == 0) {
+            clear();
+            return;
+        }
+        n_passos--;
+        const std::uint8_t codigo = ler(palavras.data(), n_passos);
+        fim = andar(fim, codigo ^ 1);
+        const std::size_t deslocamento = (n_passos % PASSOS_POR_PALAVRA) * 2;
+        if (deslocamento == 0) palavras.pop_back();
+        else palavras.back() &= ~(std::uint64_t{3} << deslocamento);
+    }
+
+    [[nodiscard]] Pos front() const { return inicio; }
+    [[nodiscard]] Pos back() const { return fim; }
+    // Número de células (passos + 1), igual ao size() do std::vector<Pos> equivalente
+    [[nodiscard]] std::size_t size() const { return vazio ? 0 : n_passos + 1; }
+    [[nodiscard]] bool empty() const { return vazio; }
+    [[nodiscard]] std::size_t bytes_usados() const { return palavras.size() * sizeof(std::uint64_t); }
+
+    [[nodiscard]] Iterador begin() const { return {palavras.data(), n_passos, inicio, 0}; }
+    [[nodiscard]] Iterador end() const { return {palavras.data(), n_passos, fim, size()}; }
+
+    // Conversão de/para o caminho por extenso (para quem precisa de acesso aleatório, como o EncurtadorCaminho).
+    // Os dois reaproveitam a capacidade do destino
+    void codificar(const std::vector<Pos>& caminho);
+    void decodificar(std::vector<Pos>& destino) const;
+
+    // Checkpoint: o início, o fim e as palavras, do jeito que estão
+    void salvar_estado(EscritorBinario& escritor) const {
+        escritor.valor(inicio);
+        escritor.valor(fim);
+        escritor.valor(static_cast<std::uint64_t>(n_passos));
+        escritor.valor(static_cast<std::uint8_t>(vazio));
+        escritor.vetor(palavras);
+    }
+    void carregar_estado(LeitorBinario& leitor) {
+        inicio = leitor.valor<Pos>();
+        fim = leitor.valor<Pos>();
+        n_passos = leitor.valor<std::uint64_t>();
+        vazio = leitor.valor<std::uint8_t>() != 0;
+        leitor.vetor(palavras);
+        if (palavras.size() != (n_passos + PASSOS_POR_PALAVRA - 1) / PASSOS_POR_PALAVRA) {
+            throw std::runtime_error("Checkpoint truncado ou invalido!");
+        }
+    }
+
+    bool operator==(const CaminhoCompacto& outro) const {
+        return size() == outro.size() && (vazio || (inicio == outro.inicio && palavras == outro.palavras));
+    }
+
+private:
+    static constexpr std::size_t PASSOS_POR_PALAVRA = 32;
+
+    Pos inicio{}, fim{};
+    std::size_t n_passos = 0;
+    bool vazio = true;
+    std::vector<std::uint64_t> palavras;
+
+    static std::uint8_t ler(const std::uint64_t* palavras, const std::size_t passo) {
+        return (palavras[passo / PASSOS_POR_PALAVRA] >> ((passo % PASSOS_POR_PALAVRA) * 2)) & 3;
+    }
+    static Pos andar(const Pos& p, const std::uint8_t codigo) {
+        switch (codigo) {
+            case 0: return {p.x - 1, p.y};
+            case 1: return {p.x + 1, p.y};
+            case 2: return {p.x, p.y - 1};
+            default: return {p.x, p.y + 1};
+        }
+    }
+};
+
+
+#endif //ACO_LABIRINTO_CAMINHOCOMPACTO_H
@@ -0,0 +1,119 @@
+#include "Checkpoint.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+GravadorCheckpoint::GravadorCheckpoint(std::string caminho)
+    :   caminho(std::move(caminho)),
+        escritor(&GravadorCheckpoint::loop_escritor, this)
+{
+}
+
+GravadorCheckpoint::~GravadorCheckpoint() {
+    {
+        std::lock_guard trava(mutex);
+        parar = true;
+    }
+    condicao.notify_all();
+    escritor.join();
+}
+
+void GravadorCheckpoint::publicar(const Labirinto &lab, const ConfigColonia &config,
+                                  const EstadoExecucao &execucao) {
+    CabecalhoCheckpoint cabecalho{};
+    std::copy(std::begin(MAGICO_CHECKPOINT), std::end(MAGICO_CHECKPOINT), cabecalho.magico);
+    cabecalho.versao = VERSAO_CHECKPOINT;
+    cabecalho.largura = lab.get_largura();
+    cabecalho.altura = lab.get_altura();
+    cabecalho.n_formigas = config.n_formigas;
+    cabecalho.semente = config.semente;
+    cabecalho.iteracao = execucao.iteracao;
+    cabecalho.estagnacao = execucao.estagnacao;
+    cabecalho.tamanho_corpo = buffer.size() - sizeof(CabecalhoCheckpoint);
+    std::memcpy(buffer.data(), &cabecalho, sizeof(cabecalho));
+
+    {
+        std::lock_guard trava(mutex);
+        // o que ainda não foi pego pela thread é descartado, e o vetor dele volta para ser o próximo buffer
+        pendente.swap(buffer);
+        tem_pendente = true;
+    }
+    condicao.notify_all();
+}
+
+void GravadorCheckpoint::esperar() {
+    std::unique_lock trava(mutex);
+    condicao.wait(trava, [this] { return !tem_pendente && !escrevendo; });
+}
+
+void GravadorCheckpoint::loop_escritor() {
+    std::vector<char> dados;
+    while (true) {
+        {
+            std::unique_lock trava(mutex);
+            condicao.wait(trava, [this] { return tem_pendente || parar; });
+            if (!tem_pendente) break; // parar e nada na fila
+            dados.swap(pendente);
+            tem_pendente = false;
+            escrevendo = true;
+        }
+
+        const std::string temporario = caminho + ".tmp";
+        bool ok;
+        {
+            std::ofstream arquivo(temporario, std::ios::binary | std::ios::trunc);
+            arquivo.write(dados.data(), static_cast<std::streamsize>(dados.size()));
+            arquivo.close();
+            ok = !arquivo.fail();
+        }
+#ifdef _WIN32
+        if (ok) std::remove(caminho.c_str()); // o rename do Windows não passa por cima
+#endif
+        if (!ok || std::rename(temporario.c_str(), caminho.c_str()) != 0) {
+            // não derruba a execução, o checkpoint anterior continua valendo
+            std::cerr << "ERRO! Nao foi possivel salvar o checkpoint em " << caminho << std::endl;
+        }
+
+        {
+            std::lock_guard trava(mutex);
+            escrevendo = false;
+        }
+        condicao.notify_all();
+    }
+}
+
+void ler_checkpoint(const std::string &caminho, const Labirinto &lab, const ConfigColonia &config,
+                    CabecalhoCheckpoint &cabecalho, std::vector<char> &corpo) {
+    std::ifstream arquivo(caminho, std::ios::binary);
+    if (!arquivo.is_open()) throw std::runtime_error("Nao foi possivel abrir o checkpoint " + caminho);
+
+    arquivo.read(reinterpret_cast<char*>(&cabecalho), sizeof(cabecalho));
+    if (!arquivo || !std::equal(std::begin(MAGICO_CHECKPOINT), std::end(MAGICO_CHECKPOINT), cabecalho.magico)) {
+        throw std::runtime_error(caminho + " nao e um checkpoint!");
+    }
+    if (cabecalho.versao != VERSAO_CHECKPOINT) {
+        throw std::runtime_error("Versao de checkpoint nao suportada: " + std::to_string(cabecalho.versao));
+    }
+    if (cabecalho.largura != static_cast<std::uint32_t>(lab.get_largura())
+        || cabecalho.altura != static_cast<std::uint32_t>(lab.get_altura())) {
+        throw std::runtime_error("O checkpoint e de um labirinto de outro tamanho!");
+    }
+    if (cabecalho.n_formigas != static_cast<std::uint32_t>(config.n_formigas) || cabecalho.semente != config.semente) {
+        throw std::runtime_error("O checkpoint e de outra configuracao (n_formigas ou semente diferentes)!");
+    }
+
+    // confere com o tamanho do arquivo antes de alocar
+    const auto inicio_corpo = arquivo.tellg();
+    arquivo.seekg(0, std::ios::end);
+    if (static_cast<std::uint64_t>(arquivo.tellg() - inicio_corpo) != cabecalho.tamanho_corpo) {
+        throw std::runtime_error("Checkpoint truncado ou invalido!");
+    }
+    arquivo.seekg(inicio_corpo);
+
+    corpo.resize(cabecalho.tamanho_corpo);
+    arquivo.read(corpo.data(), static_cast<std::streamsize>(corpo.size()));
+    if (!arquivo) throw std::runtime_error("Checkpoint truncado ou invalido!");
+}
@@ -0,0 +1,102 @@
+#ifndef ACO_LABIRINTO_CHECKPOINT_H
+#define ACO_LABIRINTO_CHECKPOINT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Colonia.h"
+#include "Labirinto.h"
+#include "Serializacao.h"
+
+// Formato do checkpoint (ordem de bytes da máquina, como o resto):
+//   CabecalhoCheckpoint (64 bytes)
+//   corpo de tamanho_corpo bytes: Labirinto::salvar_estado e depois ColoniaAco::salvar_estado
+// Guarda tudo que o loop do main precisa para continuar exatamente igual: paredes, feromônio (double, bit a bit),
+// evaporação preguiçosa, melhor caminho global (2 bits por passo), estado da política, iteração e estagnação.
+// O arquivo é sempre trocado inteiro: a escrita vai para "<arquivo>.tmp", que depois é renomeado por cima, então
+// uma execução interrompida no meio da escrita deixa o checkpoint anterior intacto
+constexpr char MAGICO_CHECKPOINT[8] = {'A', 'C', 'O', 'C', 'K', 'P', 'T', '\0'};
+constexpr std::uint32_t VERSAO_CHECKPOINT = 1;
+
+struct CabecalhoCheckpoint {
+    char magico[8];
+    std::uint32_t versao;
+    std::uint32_t largura, altura;
+    std::uint32_t n_formigas; // conferidos na volta com o config da colônia que vai carregar
+    std::uint64_t semente;
+    std::int32_t iteracao; // a próxima iteração do loop
+    std::int32_t estagnacao;
+    std::uint64_t tamanho_corpo;
+    std::uint8_t reservado[16];
+};
+static_assert(sizeof(CabecalhoCheckpoint) == 64);
+
+// Onde o loop do main estava
+struct EstadoExecucao {
+    int iteracao = 0;
+    int estagnacao = 0;
+};
+
+// Escreve os checkpoints numa thread separada, como o GravadorSnapshots. enviar() só serializa o estado num buffer
+// (cópia de memória) e volta pra colônia. Se o anterior ainda estiver esperando a thread, ele é trocado pelo novo
+// (só o mais recente interessa), então a colônia nunca espera o disco
+class GravadorCheckpoint {
+public:
+    explicit GravadorCheckpoint(std::string caminho);
+    ~GravadorCheckpoint(); // escreve o que estiver na fila antes de sair
+    GravadorCheckpoint(const GravadorCheckpoint&) = delete;
+    GravadorCheckpoint& operator=(const GravadorCheckpoint&) = delete;
+
+    template<class ColoniaT>
+    void enviar(const Labirinto& lab, const ColoniaT& colonia, const EstadoExecucao& execucao) {
+        buffer.resize(sizeof(CabecalhoCheckpoint)); // o cabeçalho é preenchido no final, com o tamanho do corpo
+        EscritorBinario escritor(buffer);
+        lab.salvar_estado(escritor);
+        colonia.salvar_estado(escritor);
+        publicar(lab, colonia.get_config(), execucao);
+    }
+    // Espera a thread escrever tudo que foi enviado até agora
+    void esperar();
+
+private:
+    std::string caminho;
+    std::vector<char> buffer; // preenchido pela colônia
+    std::vector<char> pendente; // na fila da thread
+    bool tem_pendente = false;
+    bool escrevendo = false;
+    bool parar = false;
+    std::mutex mutex;
+    std::condition_variable condicao;
+    std::thread escritor; // por último, só começa depois de tudo acima existir
+
+    void publicar(const Labirinto& lab, const ConfigColonia& config, const EstadoExecucao& execucao);
+    void loop_escritor();
+};
+
+// Lê o cabeçalho e o corpo, conferindo o cabeçalho com o labirinto e o config (fica separado do template)
+void ler_checkpoint(const std::string& caminho, const Labirinto& lab, const ConfigColonia& config,
+                    CabecalhoCheckpoint& cabecalho, std::vector<char>& corpo);
+
+// Carrega o checkpoint em lab e colonia e devolve onde o loop parou. Os dois têm que ser criados do mesmo jeito que
+// na execução que salvou (mesmo labirinto, mesmo config, mesma variante); o carregar passa por cima do feromônio e
+// do estado da colônia. Arquivo corrompido, de outro labirinto ou de outra configuração dá runtime_error
+template<class ColoniaT>
+EstadoExecucao carregar_checkpoint(const std::string& caminho, Labirinto& lab, ColoniaT& colonia) {
+    CabecalhoCheckpoint cabecalho{};
+    std::vector<char> corpo;
+    ler_checkpoint(caminho, lab, colonia.get_config(), cabecalho, corpo);
+
+    LeitorBinario leitor(corpo.data(), corpo.data() + corpo.size());
+    lab.carregar_estado(leitor);
+    colonia.carregar_estado(leitor); // confere a variante
+    if (!leitor.terminou()) throw std::runtime_error("Checkpoint truncado ou invalido!");
+    return {cabecalho.iteracao, cabecalho.estagnacao};
+}
+
+
+#endif //ACO_LABIRINTO_CHECKPOINT_H
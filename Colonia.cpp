@@ -0,0 +1,353 @@
+#include "Colonia.h"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template<class Politica>
+ColoniaAco<Politica>::ColoniaAco(Labirinto &labirinto, const ConfigColonia &config)
+    :   lab(labirinto),
+        config(config),
+        politica(labirinto, this->config),
+        encurtador(labirinto, config.raio_religacao)
+{
+    if (this->config.max_passos_timeout <= 0) {
+        this->config.max_passos_timeout = lab.get_largura() * lab.get_altura() * 2;
+    }
+
+    preparar_labirinto();
+
+    formigas.reserve(this->config.n_formigas); // reserva o número necessário de espaço, é otimizado
+    for (int i=0; i<this->config.n_formigas; i++) {
+        // emplace_back funciona bem parecido com push_back, mas não recebe uma cópia, é mais otimizado
+        formigas.emplace_back(lab, this->config.alfa, this->config.beta, this->config.modo_visitados);
+    }
+    formigas_com_sucesso.reserve(this->config.n_formigas);
+    if (this->config.poda != ModoPoda::DESLIGADA) {
+        for (auto& formiga : formigas) formiga.set_limite_poda(&limite_poda);
+    }
+    for (auto& formiga : formigas) formiga.set_q0(this->config.acs_q0);
+    passos_formiga.assign(this->config.n_formigas, 0);
+    timeout_formiga.assign(this->config.n_formigas, 0);
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::preparar_labirinto() {
+    lab.preparar_heuristica(config.beta);
+    if (config.cache_feromonio_alfa && classificar_expoente(config.alfa) == TipoExpoente::GENERICO
+        && lab.get_modo_evaporacao() == ModoEvaporacao::IMEDIATA) {
+        lab.ativar_cache_feromonio_alfa(config.alfa);
+    }
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::reiniciar() {
+    preparar_labirinto();
+    for (auto& formiga : formigas) formiga.atualizar_ninho_comida();
+    for (const auto& lote : lotes) lote->atualizar_ninho_comida();
+    politica.reiniciar();
+    melhor_caminho_global.clear();
+    menor_tamanho_global = -1;
+    limite_poda.store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+    metricas = MetricasIteracao{};
+    iteracao = 0;
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::construir_solucoes() {
+    metricas = MetricasIteracao{};
+    metricas.iteracao = iteracao;
+    Cronometro cronometro(metricas.t_construcao);
+
+    if (config.motor == MotorFormigas::ESCALAR) construir_escalar();
+    else construir_em_lote();
+
+    if constexpr (Politica::ATUALIZACAO_LOCAL) {
+        // fora do loop paralelo e na ordem das formigas, para não depender das threads
+        for (const Formiga& formiga : formigas) politica.atualizacao_local(formiga.get_pilha_solucao());
+    }
+
+    if constexpr (METRICAS_ATIVAS) consolidar_metricas_construcao();
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::construir_escalar() {
+    const int n = static_cast<int>(formigas.size());
+
+    // cada formiga só lê o labirinto e escreve nela mesma, então dá pra dividir o loop entre os núcleos.
+    // schedule(dynamic) porque umas formigas acham a comida rápido e outras ficam presas em becos
+    #pragma omp parallel for schedule(dynamic)
+    for (int i=0; i<n; i++) {
+        Formiga& formiga = formigas[i];
+        formiga.semear(config.semente, i, iteracao);
+        timeout_formiga[i] = 0;
+        formiga.reset();
+
+        const long long passos = formiga.template andar<typename Politica::Regra>(config.max_passos_timeout);
+        if (passos > config.max_passos_timeout) timeout_formiga[i] = 1;
+        passos_formiga[i] = passos;
+
+        if (config.poda == ModoPoda::IMEDIATA && formiga.encontrou_comida()) {
+            // "atomic min": só troca se o novo tamanho for menor que o que está lá
+            const int tamanho = static_cast<int>(formiga.get_pilha_solucao().size());
+            int atual = limite_poda.load(std::memory_order_relaxed);
+            while (tamanho < atual
+                   && !limite_poda.compare_exchange_weak(atual, tamanho, std::memory_order_relaxed)) {}
+        }
+    }
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::construir_em_lote() {
+    int n_threads = 1;
+#ifdef _OPENMP
+    n_threads = omp_get_max_threads();
+#endif
+    // o número de threads pode mudar entre chamadas (as ilhas dividem as threads), então cria os que faltarem
+    while (static_cast<int>(lotes.size()) < n_threads) {
+        lotes.push_back(std::make_unique<LoteFormigas>(lab, config, config.motor == MotorFormigas::LOTE));
+    }
+    std::atomic<int>* limite = config.poda != ModoPoda::DESLIGADA ? &limite_poda : nullptr;
+    proxima_formiga.store(0, std::memory_order_relaxed);
+
+    // cada thread pega formigas da mesma fila. Cada formiga tem o seu fluxo aleatório, então não importa qual lote
+    // (nem qual lane) anda com ela
+    #pragma omp parallel
+    {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        lotes[thread]->construir<typename Politica::Regra>(formigas, proxima_formiga, iteracao, passos_formiga,
+                                                           timeout_formiga, limite);
+    }
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::consolidar_metricas_construcao() {
+    tamanhos_sucesso.clear();
+    for (size_t i=0; i<formigas.size(); i++) {
+        metricas.passos += passos_formiga[i];
+        metricas.retrocessos += formigas[i].get_retrocessos();
+        if (formigas[i].encontrou_comida()) {
+            metricas.sucessos++;
+            tamanhos_sucesso.push_back(static_cast<int>(formigas[i].get_pilha_solucao().size()));
+        }
+        else if (formigas[i].podada()) metricas.podadas++;
+        else if (timeout_formiga[i]) metricas.timeouts++;
+        else metricas.falhas++;
+    }
+    resumir_tamanhos(tamanhos_sucesso, metricas);
+}
+
+template<class Politica>
+ResultadoIteracao ColoniaAco<Politica>::atualizar_feromonios() {
+    ResultadoIteracao resultado;
+    evaporar();
+    selecionar_elite(resultado);
+    depositar_elite(resultado);
+    return resultado;
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::evaporar() {
+    Cronometro cronometro(metricas.t_evaporacao);
+    politica.evaporar();
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::selecionar_elite(ResultadoIteracao &resultado) {
+    Cronometro cronometro(metricas.t_ordenacao);
+    formigas_com_sucesso.clear();
+    for (const Formiga& formiga : formigas) {
+        resultado.n_podadas += formiga.podada();
+        if (formiga.encontrou_comida()) {
+            formigas_com_sucesso.push_back(&formiga);
+            const int tamanho_caminho = static_cast<int>(formiga.get_pilha_solucao().size());
+            if (resultado.menor_tamanho_iteracao == -1 || tamanho_caminho < resultado.menor_tamanho_iteracao) {
+                resultado.menor_tamanho_iteracao = tamanho_caminho;
+            }
+        }
+    }
+    resultado.n_sucessos = static_cast<int>(formigas_com_sucesso.size());
+
+    // só as n_depositantes() melhores são usadas, então basta uma ordenação parcial. O desempate pelo endereço é a
+    // ordem das formigas (estão todas no mesmo vetor), o mesmo resultado que o stable_sort de antes dava
+    const int n_elite = std::min(static_cast<int>(formigas_com_sucesso.size()), politica.n_depositantes());
+    std::partial_sort(formigas_com_sucesso.begin(), formigas_com_sucesso.begin() + n_elite, formigas_com_sucesso.end(),
+        [](const Formiga* a, const Formiga* b) {
+            const size_t tamanho_a = a->get_pilha_solucao().size(), tamanho_b = b->get_pilha_solucao().size();
+            return tamanho_a != tamanho_b ? tamanho_a < tamanho_b : a < b;
+        });
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::depositar_elite(ResultadoIteracao &resultado) {
+    Cronometro cronometro(metricas.t_deposito);
+    const int n_elite = std::min(static_cast<int>(formigas_com_sucesso.size()), politica.n_depositantes());
+    if (static_cast<int>(caminhos_elite.size()) < n_elite) caminhos_elite.resize(n_elite);
+
+    for (int i=0; i<n_elite; i++) {
+        const CaminhoCompacto& caminho = formigas_com_sucesso[i]->get_pilha_solucao();
+        if (config.encurtar_caminhos) {
+            caminho.decodificar(caminho_por_extenso);
+            encurtador.encurtar(caminho_por_extenso);
+            caminhos_elite[i].codificar(caminho_por_extenso);
+        }
+        else caminhos_elite[i] = caminho; // a atribuição reaproveita a capacidade
+    }
+    // encurtar pode mudar a ordem, e o rank depende dela. São poucos caminhos, então uma inserção estável (as
+    // trocas só movem os vetores de dentro, sem alocar)
+    if (config.encurtar_caminhos) {
+        for (int i=1; i<n_elite; i++) {
+            for (int j=i; j>0 && caminhos_elite[j-1].size() > caminhos_elite[j].size(); j--) {
+                std::swap(caminhos_elite[j-1], caminhos_elite[j]);
+            }
+        }
+    }
+
+    if (n_elite > 0) {
+        // a poda compara com o que uma formiga consegue andar, então usa o caminho como ela andou. O encurtado
+        // pode ser menor que qualquer caminhada, e aí a poda cortaria todas as formigas
+        const int tamanho_andado = static_cast<int>(formigas_com_sucesso[0]->get_pilha_solucao().size());
+        if (tamanho_andado < limite_poda.load(std::memory_order_relaxed)) {
+            limite_poda.store(tamanho_andado, std::memory_order_relaxed);
+        }
+
+        const int tamanho = static_cast<int>(caminhos_elite[0].size());
+        // o encurtado pode ficar menor que o melhor da iteração que o selecionar_elite viu
+        if (tamanho < resultado.menor_tamanho_iteracao) resultado.menor_tamanho_iteracao = tamanho;
+        if (menor_tamanho_global == -1 || tamanho < menor_tamanho_global) {
+            menor_tamanho_global = tamanho;
+            melhor_caminho_global = caminhos_elite[0];
+            resultado.melhorou_global = true;
+        }
+    }
+
+    politica.depositar(caminhos_elite, n_elite, melhor_caminho_global, iteracao);
+
+    metricas.melhor_global = menor_tamanho_global;
+    iteracao++;
+}
+
+template<class Politica>
+ResultadoIteracao ColoniaAco<Politica>::iterar() {
+    construir_solucoes();
+    return atualizar_feromonios();
+}
+
+template<class Politica>
+bool ColoniaAco<Politica>::importar_caminho(const CaminhoCompacto &caminho) {
+    const int tamanho = static_cast<int>(caminho.size());
+    if (caminho.empty() || (menor_tamanho_global != -1 && tamanho >= menor_tamanho_global)) return false;
+
+    // a poda continua com o limite das formigas desta colônia: o caminho de fora pode ter sido encurtado
+    menor_tamanho_global = tamanho;
+    melhor_caminho_global = caminho;
+    return true;
+}
+
+template<class Politica>
+EfeitoAlteracao ColoniaAco<Politica>::alterar_paredes(const std::vector<AlteracaoParede> &alteracoes) {
+    bool fechou = false;
+    for (const AlteracaoParede& alteracao : alteracoes) {
+        lab.set_parede(alteracao.celula, alteracao.parede);
+        for (const auto& lote : lotes) {
+            if (lote) lote->atualizar_parede(alteracao.celula);
+        }
+        fechou |= alteracao.parede;
+    }
+    if (!fechou) return EfeitoAlteracao::INTACTO;
+    // a caminhada que deu o limite da poda pode ter passado pela parede nova, então a poda recomeça sem limite
+    limite_poda.store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+    if (melhor_caminho_global.empty()) return EfeitoAlteracao::INTACTO;
+
+    melhor_caminho_global.decodificar(caminho_por_extenso);
+    if (std::ranges::none_of(caminho_por_extenso, [this](const Pos& p) { return lab.parede_rapida(p); })) {
+        return EfeitoAlteracao::INTACTO;
+    }
+
+    if (encurtador.reparar(caminho_por_extenso, config.raio_reparo)) {
+        melhor_caminho_global.codificar(caminho_por_extenso);
+        menor_tamanho_global = static_cast<int>(melhor_caminho_global.size());
+        return EfeitoAlteracao::REPARADO;
+    }
+    melhor_caminho_global.clear();
+    menor_tamanho_global = -1;
+    return EfeitoAlteracao::DESCARTADO;
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::salvar_estado(EscritorBinario &escritor) const {
+    escritor.valor(Politica::ID_CHECKPOINT);
+    escritor.valor(iteracao);
+    escritor.valor(menor_tamanho_global);
+    escritor.valor(limite_poda.load(std::memory_order_relaxed));
+    melhor_caminho_global.salvar_estado(escritor);
+    politica.salvar_estado(escritor);
+}
+
+template<class Politica>
+void ColoniaAco<Politica>::carregar_estado(LeitorBinario &leitor) {
+    if (leitor.valor<std::uint32_t>() != Politica::ID_CHECKPOINT) {
+        throw std::runtime_error("O checkpoint e de outra variante do ACO!");
+    }
+    iteracao = leitor.valor<int>();
+    menor_tamanho_global = leitor.valor<int>();
+    limite_poda.store(leitor.valor<int>(), std::memory_order_relaxed);
+    melhor_caminho_global.carregar_estado(leitor);
+    politica.carregar_estado(leitor);
+    lotes.clear(); // as marcas de parede são refeitas na próxima construção, as paredes podem ter mudado
+}
+
+// Getters
+
+template<class Politica>
+int ColoniaAco<Politica>::get_iteracao() const {
+    return iteracao;
+}
+
+template<class Politica>
+const MetricasIteracao& ColoniaAco<Politica>::get_metricas() const {
+    return metricas;
+}
+
+template<class Politica>
+int ColoniaAco<Politica>::get_menor_tamanho_global() const {
+    return menor_tamanho_global;
+}
+
+template<class Politica>
+const CaminhoCompacto& ColoniaAco<Politica>::get_melhor_caminho_global() const {
+    return melhor_caminho_global;
+}
+
+template<class Politica>
+const std::vector<Formiga>& ColoniaAco<Politica>::get_formigas() const {
+    return formigas;
+}
+
+template<class Politica>
+const ConfigColonia& ColoniaAco<Politica>::get_config() const {
+    return config;
+}
+
+template<class Politica>
+long long ColoniaAco<Politica>::get_passos_ultima_iteracao() const {
+    long long total = 0;
+    for (const long long passos : passos_formiga) total += passos;
+    return total;
+}
+
+template<class Politica>
+const Politica& ColoniaAco<Politica>::get_politica() const {
+    return politica;
+}
+
+// As variantes que existem. Uma política nova precisa entrar aqui também
+template class ColoniaAco<PoliticaElitista>;
+template class ColoniaAco<PoliticaMMAS>;
+template class ColoniaAco<PoliticaACS>;
+template class ColoniaAco<PoliticaRank>;
@@ -0,0 +1,168 @@
+#ifndef ACO_LABIRINTO_COLONIA_H
+#define ACO_LABIRINTO_COLONIA_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "CaminhoCompacto.h"
+#include "EncurtadorCaminho.h"
+#include "Formiga.h"
+#include "Labirinto.h"
+#include "LoteFormigas.h"
+#include "Metricas.h"
+#include "PoliticasAco.h"
+
+// Poda das formigas que já não conseguem empatar com a menor caminhada até a comida (caminho atual + distância
+// Manhattan até a comida > limite). Elas desistem e aparecem separadas das falhas de verdade. O limite é o caminho
+// como a formiga andou, não o encurtado do melhor global: nenhuma caminhada chegaria no encurtado.
+// ENTRE_ITERACOES: o limite é o do começo da iteração, o resultado continua igual com qualquer número
+//                  de threads.
+// IMEDIATA: além disso, uma formiga que acha comida durante a construção já aperta o limite para as outras. Poda
+//           mais, mas aí o resultado depende da ordem em que as threads terminam
+enum class ModoPoda { DESLIGADA, ENTRE_ITERACOES, IMEDIATA };
+
+// Hiperparâmetros de uma colônia. Os valores padrão são os mesmos que o main.cpp usava
+struct ConfigColonia {
+    int n_formigas = 100;
+    double alfa = 1.0;  // Peso do feromônio
+    double beta = 4.0;  // Peso da heurística
+    double taxa_evaporacao = 0.35;
+    double intensidade_feromonio = 1.0; // Valor base do depósito, dividido pelo tamanho do caminho
+    double min_feromonio = 0.01;
+    int max_passos_timeout = 0; // 0 = usa 2*largura*altura
+    int elite = 5; // quantas formigas depositam feromônio por iteração
+    std::uint64_t semente = 42; // semente mestre, cada formiga deriva o seu fluxo dela
+    // Guarda feromonio^alfa por célula no Labirinto. Só vale a pena com alfa não inteiro (os inteiros já têm versão
+    // sem std::pow) e só funciona com evaporação IMEDIATA, nos outros casos é ignorado
+    bool cache_feromonio_alfa = false;
+    ModoVisitados modo_visitados = ModoVisitados::AUTOMATICO; // como cada formiga guarda as células visitadas
+    ModoPoda poda = ModoPoda::DESLIGADA;
+    MotorFormigas motor = MotorFormigas::ESCALAR; // como as formigas andam na construção (LoteFormigas.h)
+    // Encurta os caminhos da elite (EncurtadorCaminho) antes de depositar. raio_religacao > 0 liga também a
+    // religação por BFS. Só a Colonia normal usa, a ColoniaGrafo ignora
+    bool encurtar_caminhos = false;
+    int raio_religacao = 0;
+    // Labirinto dinâmico (alterar_paredes): até quantos passos a BFS procura um desvio quando o melhor caminho
+    // global fica bloqueado. Sem desvio dentro do raio o melhor global é descartado
+    int raio_reparo = 16;
+
+    // Parâmetros das variantes (PoliticasAco.h), cada política ignora os das outras
+    double mmas_p_melhor = 0.05; // chance de a formiga refazer o melhor caminho quando tudo está no tau_min/tau_max
+    int mmas_intervalo_global = 5; // de quantas em quantas iterações o melhor global deposita no lugar do da iteração
+    double acs_q0 = 0.9; // chance de ir direto no caminho mais atrativo
+    double acs_taxa_local = 0.1; // peso da atualização local
+};
+
+// Uma célula que abre (parede = false) ou fecha
+struct AlteracaoParede {
+    Pos celula;
+    bool parede;
+};
+
+// O que o alterar_paredes fez com o melhor caminho global
+enum class EfeitoAlteracao {
+    INTACTO,    // nenhuma célula dele fechou (ou ainda não tinha melhor global)
+    REPARADO,   // passava por célula fechada e foi desviado (pode ter ficado maior)
+    DESCARTADO  // não deu para desviar, a colônia volta a ficar sem melhor global
+};
+
+struct ResultadoIteracao {
+    int menor_tamanho_iteracao = -1; // -1 = nenhuma formiga achou a comida
+    int n_sucessos = 0;
+    int n_podadas = 0; // desistiram pela poda (não entram como sucesso nem como falha)
+    bool melhorou_global = false;
+};
+
+// Roda o ciclo do ACO (formigas andando, evaporação e depósito) em cima de um Labirinto. A variante (quem deposita,
+// quanto, e como a formiga escolhe o passo) é a Politica, ver PoliticasAco.h.
+// As definições ficam no Colonia.cpp, com as políticas que existem instanciadas lá no final
+template<class Politica>
+class ColoniaAco {
+public:
+    ColoniaAco(Labirinto& labirinto, const ConfigColonia& config);
+
+    // Fase de construção: todas as formigas andam até achar comida, falhar ou estourar o timeout.
+    // Com OpenMP ativado, as formigas são divididas entre as threads
+    void construir_solucoes();
+    // Evaporação + depósito das melhores formigas, do jeito da Politica
+    ResultadoIteracao atualizar_feromonios();
+    // As fases do atualizar_feromonios separadas, para medir cada uma (benchmark/instrumentação).
+    // depositar_elite fecha a iteração
+    void evaporar();
+    void selecionar_elite(ResultadoIteracao& resultado);
+    void depositar_elite(ResultadoIteracao& resultado);
+    // Uma iteração completa (construir + atualizar)
+    ResultadoIteracao iterar();
+    // Caminho que veio de fora (outra ilha). Se for menor que o melhor global ele vira o melhor global, e a política
+    // passa a depositar nele como deposita no próprio. Retorna se trocou
+    bool importar_caminho(const CaminhoCompacto& caminho);
+    // Labirinto dinâmico: abre/fecha células entre duas iterações, mantendo o feromônio que já existe (o
+    // recomeço é quente). Atualiza as marcas de parede dos lotes e, se o melhor global passava por uma célula que
+    // fechou, tenta desviar ele (raio_reparo) antes de descartar. Abrir não mexe no melhor global: o atalho novo
+    // fica para as formigas acharem. Mesmas regras do Labirinto::set_parede
+    EfeitoAlteracao alterar_paredes(const std::vector<AlteracaoParede>& alteracoes);
+    // Checkpoint (Checkpoint.h): a iteração, o melhor global, a poda e o estado da Politica. As formigas não vão,
+    // o gerador de cada uma sai de (semente, formiga, iteração) no começo da iteração. O carregar precisa de uma
+    // colônia com o mesmo config, no Labirinto já carregado
+    void salvar_estado(EscritorBinario& escritor) const;
+    void carregar_estado(LeitorBinario& leitor);
+    // Começa do zero no Labirinto como ele está agora (ninho/comida trocados com set_ninho_comida, feromônio do
+    // reiniciar_feromonios), com o mesmo config: iteração, melhor global, poda e política voltam ao começo. As
+    // formigas (com os visitados) e os lotes são reaproveitados, então não aloca nada. Dá o mesmo resultado que uma
+    // colônia nova
+    void reiniciar();
+
+    [[nodiscard]] int get_iteracao() const;
+    // Métricas da última iteração completa (zeradas se compilado com ACO_METRICAS=0)
+    [[nodiscard]] const MetricasIteracao& get_metricas() const;
+    [[nodiscard]] int get_menor_tamanho_global() const;
+    [[nodiscard]] const CaminhoCompacto& get_melhor_caminho_global() const;
+    [[nodiscard]] const std::vector<Formiga>& get_formigas() const;
+    [[nodiscard]] const ConfigColonia& get_config() const;
+    [[nodiscard]] long long get_passos_ultima_iteracao() const; // passos dados na última construção
+    [[nodiscard]] const Politica& get_politica() const;
+
+private:
+    Labirinto& lab;
+    ConfigColonia config;
+    Politica politica; // guarda uma referência para o config de cima, precisa vir depois dele
+
+    std::vector<Formiga> formigas;
+    // reaproveitado entre iterações. Depois do selecionar_elite só os n_depositantes() primeiros estão em ordem
+    std::vector<const Formiga*> formigas_com_sucesso;
+    std::vector<long long> passos_formiga;
+    std::vector<std::uint8_t> timeout_formiga;
+    MetricasIteracao metricas;
+    std::vector<int> tamanhos_sucesso; // reaproveitado para a distribuição de tamanhos
+    EncurtadorCaminho encurtador;
+    std::vector<CaminhoCompacto> caminhos_elite; // cópias (encurtadas) dos caminhos que vão para o depositar
+    std::vector<Pos> caminho_por_extenso; // o encurtador trabalha no caminho decodificado
+
+    void consolidar_metricas_construcao();
+    void preparar_labirinto(); // heurística e cache de feromônio^alfa, no construtor e no reiniciar
+
+    // Motor em lote: um LoteFormigas por thread (criados na primeira construção) e a fila de formigas que eles dividem
+    std::vector<std::unique_ptr<LoteFormigas>> lotes;
+    std::atomic<int> proxima_formiga{0};
+    void construir_escalar();
+    void construir_em_lote();
+
+    CaminhoCompacto melhor_caminho_global;
+    int menor_tamanho_global = -1;
+    int iteracao = 0;
+
+    // limite de tamanho lido pelas formigas na poda: a menor caminhada de uma formiga até a comida, sem encurtar
+    // (INT_MAX enquanto nenhuma chegou). Separado do menor_tamanho_global, que é do caminho encurtado
+    std::atomic<int> limite_poda{std::numeric_limits<int>::max()};
+};
+
+using Colonia = ColoniaAco<PoliticaElitista>; // o esquema original
+using ColoniaMMAS = ColoniaAco<PoliticaMMAS>;
+using ColoniaACS = ColoniaAco<PoliticaACS>;
+using ColoniaRank = ColoniaAco<PoliticaRank>;
+
+
+#endif //ACO_LABIRINTO_COLONIA_H
@@ -0,0 +1,204 @@
+#include "ColoniaGrafo.h"
+#include <algorithm>
+#include <iostream>
+
+ColoniaGrafo::ColoniaGrafo(Labirinto &labirinto, const ConfigColonia &config)
+    :   lab(labirinto),
+        config(config),
+        grafo(labirinto)
+{
+    if (this->config.max_passos_timeout <= 0) {
+        this->config.max_passos_timeout = lab.get_largura() * lab.get_altura() * 2;
+    }
+    std::clog << "GRAFO DE JUNCOES: " << grafo.get_n_nos() << " nos, " << grafo.get_n_arestas() << " arestas"
+              << std::endl;
+
+    feromonio_aresta.assign(grafo.get_n_arestas(), FEROMONIO_INICIAL);
+
+    // heuristica^beta de cada nó, tirada da tabela do Labirinto
+    lab.preparar_heuristica(this->config.beta);
+    heuristica_no.resize(grafo.get_n_nos());
+    for (int no=0; no<grafo.get_n_nos(); no++) {
+        heuristica_no[no] = lab.heuristica_beta_rapida(grafo.get_pos_no(no));
+    }
+
+    formigas.reserve(this->config.n_formigas);
+    for (int i=0; i<this->config.n_formigas; i++) {
+        formigas.emplace_back(grafo, feromonio_aresta, heuristica_no, this->config.alfa);
+    }
+    if (this->config.poda != ModoPoda::DESLIGADA) {
+        for (auto& formiga : formigas) formiga.set_limite_poda(&limite_poda);
+    }
+    passos_formiga.assign(this->config.n_formigas, 0);
+    timeout_formiga.assign(this->config.n_formigas, 0);
+    formigas_com_sucesso.reserve(this->config.n_formigas);
+}
+
+void ColoniaGrafo::construir_solucoes() {
+    metricas = MetricasIteracao{};
+    metricas.iteracao = iteracao;
+    Cronometro cronometro(metricas.t_construcao);
+
+    const int n = static_cast<int>(formigas.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int i=0; i<n; i++) {
+        FormigaGrafo& formiga = formigas[i];
+        formiga.semear(config.semente, i, iteracao);
+        timeout_formiga[i] = 0;
+        formiga.reset();
+
+        int passos_atuais = 0;
+        while (!formiga.encontrou_comida() && !formiga.falhou()) {
+            formiga.mover();
+            passos_atuais++;
+
+            if (passos_atuais > config.max_passos_timeout) {
+                formiga.falhar();
+                timeout_formiga[i] = 1;
+            }
+        }
+        passos_formiga[i] = passos_atuais;
+
+        if (config.poda == ModoPoda::IMEDIATA && formiga.encontrou_comida()) {
+            // "atomic min": só troca se o novo tamanho for menor que o que está lá
+            const int tamanho = formiga.get_tamanho_caminho();
+            int atual = limite_poda.load(std::memory_order_relaxed);
+            while (tamanho < atual
+                   && !limite_poda.compare_exchange_weak(atual, tamanho, std::memory_order_relaxed)) {}
+        }
+    }
+
+    if constexpr (METRICAS_ATIVAS) consolidar_metricas_construcao();
+}
+
+void ColoniaGrafo::consolidar_metricas_construcao() {
+    tamanhos_sucesso.clear();
+    for (size_t i=0; i<formigas.size(); i++) {
+        metricas.passos += passos_formiga[i];
+        metricas.retrocessos += formigas[i].get_retrocessos();
+        if (formigas[i].encontrou_comida()) {
+            metricas.sucessos++;
+            tamanhos_sucesso.push_back(formigas[i].get_tamanho_caminho());
+        }
+        else if (formigas[i].podada()) metricas.podadas++;
+        else if (timeout_formiga[i]) metricas.timeouts++;
+        else metricas.falhas++;
+    }
+    resumir_tamanhos(tamanhos_sucesso, metricas);
+}
+
+void ColoniaGrafo::depositar(const std::vector<int> &arestas, const int tamanho, const double intensidade) {
+    // o depósito por célula é o mesmo da versão normal (intensidade / tamanho do caminho em células), e como
+    // todas as células da aresta teriam o mesmo valor, a aresta recebe esse valor uma vez só
+    const double deposito = intensidade / static_cast<double>(tamanho);
+    for (const int aresta : arestas) {
+        feromonio_aresta[aresta] += deposito;
+    }
+}
+
+ResultadoIteracao ColoniaGrafo::atualizar_feromonios() {
+    ResultadoIteracao resultado;
+
+    {
+        Cronometro cronometro(metricas.t_evaporacao);
+        for (double& f : feromonio_aresta) {
+            f *= (1.0 - config.taxa_evaporacao);
+            f = std::max(f, config.min_feromonio);
+        }
+    }
+
+    {
+        Cronometro cronometro(metricas.t_ordenacao);
+        formigas_com_sucesso.clear();
+        for (const FormigaGrafo& formiga : formigas) {
+            resultado.n_podadas += formiga.podada();
+            if (formiga.encontrou_comida()) {
+                formigas_com_sucesso.push_back(&formiga);
+                const int tamanho_caminho = formiga.get_tamanho_caminho();
+                if (resultado.menor_tamanho_iteracao == -1 || tamanho_caminho < resultado.menor_tamanho_iteracao) {
+                    resultado.menor_tamanho_iteracao = tamanho_caminho;
+                }
+            }
+        }
+        resultado.n_sucessos = static_cast<int>(formigas_com_sucesso.size());
+
+        std::stable_sort(formigas_com_sucesso.begin(), formigas_com_sucesso.end(),
+            [](const FormigaGrafo* a, const FormigaGrafo* b) {
+                return a->get_tamanho_caminho() < b->get_tamanho_caminho();
+            });
+    }
+
+    {
+        Cronometro cronometro(metricas.t_deposito);
+        const int quantidade_deposito = std::min(static_cast<int>(formigas_com_sucesso.size()), config.elite);
+        for (int i=0; i<quantidade_deposito; i++) {
+            const FormigaGrafo& formiga = *formigas_com_sucesso[i];
+            depositar(formiga.get_pilha_arestas(), formiga.get_tamanho_caminho(), config.intensidade_feromonio);
+
+            const int tamanho = formiga.get_tamanho_caminho();
+            if (menor_tamanho_global == -1 || tamanho < menor_tamanho_global) {
+                menor_tamanho_global = tamanho;
+                melhor_nos_global = formiga.get_pilha_nos();
+                melhor_arestas_global = formiga.get_pilha_arestas();
+                grafo.expandir_caminho(melhor_nos_global, melhor_arestas_global, melhor_caminho_global);
+                resultado.melhorou_global = true;
+            }
+        }
+
+        if (!melhor_arestas_global.empty()) {
+            depositar(melhor_arestas_global, menor_tamanho_global, config.intensidade_feromonio*config.elite*0.5);
+        }
+    }
+
+    if (menor_tamanho_global != -1) limite_poda.store(menor_tamanho_global, std::memory_order_relaxed);
+    metricas.melhor_global = menor_tamanho_global;
+    iteracao++;
+    return resultado;
+}
+
+ResultadoIteracao ColoniaGrafo::iterar() {
+    construir_solucoes();
+    return atualizar_feromonios();
+}
+
+void ColoniaGrafo::exportar_feromonios() {
+    std::vector<double> maior_no(grafo.get_n_nos(), config.min_feromonio);
+    for (int e=0; e<grafo.get_n_arestas(); e++) {
+        const ArestaGrafo& aresta = grafo.get_aresta(e);
+        maior_no[aresta.origem] = std::max(maior_no[aresta.origem], feromonio_aresta[e]);
+        maior_no[aresta.destino] = std::max(maior_no[aresta.destino], feromonio_aresta[e]);
+        grafo.para_cada_celula(e, [&](const Pos& p) { lab.set_feromonio(p, feromonio_aresta[e]); });
+    }
+    for (int no=0; no<grafo.get_n_nos(); no++) {
+        lab.set_feromonio(grafo.get_pos_no(no), maior_no[no]);
+    }
+}
+
+// Getters
+
+int ColoniaGrafo::get_iteracao() const {
+    return iteracao;
+}
+
+const MetricasIteracao& ColoniaGrafo::get_metricas() const {
+    return metricas;
+}
+
+int ColoniaGrafo::get_menor_tamanho_global() const {
+    return menor_tamanho_global;
+}
+
+const std::vector<Pos>& ColoniaGrafo::get_melhor_caminho_global() const {
+    return melhor_caminho_global;
+}
+
+const GrafoJuncoes& ColoniaGrafo::get_grafo() const {
+    return grafo;
+}
+
+long long ColoniaGrafo::get_passos_ultima_iteracao() const {
+    long long total = 0;
+    for (const long long passos : passos_formiga) total += passos;
+    return total;
+}
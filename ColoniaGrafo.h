@@ -0,0 +1,62 @@
+#ifndef ACO_LABIRINTO_COLONIAGRAFO_H
+#define ACO_LABIRINTO_COLONIAGRAFO_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Colonia.h"
+#include "FormigaGrafo.h"
+#include "GrafoJuncoes.h"
+#include "Labirinto.h"
+
+// Colônia que roda em cima do GrafoJuncoes em vez de célula por célula. Usa os mesmos ConfigColonia e
+// ResultadoIteracao da Colonia normal. O feromônio fica por aresta; exportar_feromonios() joga ele de volta nas
+// células do Labirinto (para o salvar_iteracao), e o melhor caminho já sai expandido em células
+class ColoniaGrafo {
+public:
+    ColoniaGrafo(Labirinto& labirinto, const ConfigColonia& config);
+
+    void construir_solucoes();
+    ResultadoIteracao atualizar_feromonios();
+    ResultadoIteracao iterar();
+    // Cada célula de corredor recebe o feromônio da sua aresta, e cada nó o maior entre as arestas dele
+    void exportar_feromonios();
+
+    [[nodiscard]] int get_iteracao() const;
+    // Métricas da última iteração completa (zeradas se compilado com ACO_METRICAS=0)
+    [[nodiscard]] const MetricasIteracao& get_metricas() const;
+    [[nodiscard]] int get_menor_tamanho_global() const;
+    [[nodiscard]] const std::vector<Pos>& get_melhor_caminho_global() const;
+    [[nodiscard]] const GrafoJuncoes& get_grafo() const;
+    [[nodiscard]] long long get_passos_ultima_iteracao() const; // decisões tomadas na última construção
+
+private:
+    Labirinto& lab;
+    ConfigColonia config;
+    GrafoJuncoes grafo;
+
+    std::vector<double> feromonio_aresta;
+    std::vector<double> heuristica_no;
+    std::vector<FormigaGrafo> formigas;
+    std::vector<long long> passos_formiga;
+    std::vector<std::uint8_t> timeout_formiga;
+    MetricasIteracao metricas;
+    std::vector<int> tamanhos_sucesso;
+
+    void consolidar_metricas_construcao();
+    std::vector<const FormigaGrafo*> formigas_com_sucesso;
+
+    std::vector<Pos> melhor_caminho_global;
+    std::vector<int> melhor_nos_global, melhor_arestas_global;
+    int menor_tamanho_global = -1;
+    int iteracao = 0;
+
+    std::atomic<int> limite_poda{std::numeric_limits<int>::max()};
+
+    void depositar(const std::vector<int>& arestas, int tamanho, double intensidade);
+};
+
+
+#endif //ACO_LABIRINTO_COLONIAGRAFO_H
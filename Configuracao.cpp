@@ -0,0 +1,355 @@
+#include "Configuracao.h"
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+// Chaves que mudam o labirinto: a varredura gera um só, então elas não podem ter lista
+static const std::vector<std::string> CHAVES_LABIRINTO = {
+    "largura", "altura", "algoritmo_labirinto", "semente_labirinto", "chance_parede_adicional", "densidade_lacos",
+    "arquivo_labirinto", "salvar_labirinto",
+};
+// Chaves que não são de uma configuração (valem para o processo todo)
+static const std::vector<std::string> CHAVES_GLOBAIS = {"threads", "saida_varredura", "checkpoint",
+                                                        "intervalo_checkpoint", "retomar", "nivel_snapshot",
+                                                        "regiao_snapshot"};
+
+static std::string aparar(const std::string& texto) {
+    const size_t inicio = texto.find_first_not_of(" \t\r");
+    if (inicio == std::string::npos) return "";
+    const size_t fim = texto.find_last_not_of(" \t\r");
+    return texto.substr(inicio, fim - inicio + 1);
+}
+
+static std::vector<std::string> separar_lista(const std::string& lista) {
+    std::vector<std::string> itens;
+    std::stringstream ss(lista);
+    std::string item;
+    while (std::getline(ss, item, ',')) itens.push_back(aparar(item));
+    if (itens.empty()) itens.emplace_back();
+    return itens;
+}
+
+// Número com o texto inteiro consumido ("12abc" e "" são erro, o std::stoi aceitaria o primeiro)
+template<class T>
+static T ler_numero(const std::string& chave, const std::string& valor) {
+    std::istringstream ss(valor);
+    T numero{};
+    ss >> numero;
+    if (ss.fail() || !ss.eof()) throw std::runtime_error("Valor invalido para " + chave + ": '" + valor + "'");
+    return numero;
+}
+
+// Para os que dividem ou contam alguma coisa: 0 ou negativo daria divisão por zero ou nenhuma formiga
+static int ler_positivo(const std::string& chave, const std::string& valor) {
+    const int numero = ler_numero<int>(chave, valor);
+    if (numero <= 0) throw std::runtime_error("Valor invalido para " + chave + " (tem que ser > 0): '" + valor + "'");
+    return numero;
+}
+
+static bool ler_booleano(const std::string& chave, const std::string& valor) {
+    if (valor == "1" || valor == "true" || valor == "sim") return true;
+    if (valor == "0" || valor == "false" || valor == "nao") return false;
+    throw std::runtime_error("Valor invalido para " + chave + " (use 1/0): '" + valor + "'");
+}
+
+void ParametrosExecucao::definir(const std::string &chave, const std::string &lista) {
+    for (auto& [nome, itens] : this->valores) {
+        if (nome == chave) {
+            itens = separar_lista(lista);
+            return;
+        }
+    }
+    this->valores.emplace_back(chave, separar_lista(lista));
+}
+
+void ler_arquivo_config(const std::string &caminho, ParametrosExecucao &parametros) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo.is_open()) throw std::runtime_error("Nao foi possivel abrir o arquivo de configuracao " + caminho);
+
+    std::string linha;
+    int n_linha = 0;
+    while (std::getline(arquivo, linha)) {
+        n_linha++;
+        linha = aparar(linha.substr(0, linha.find('#')));
+        if (linha.empty()) continue;
+        const size_t igual = linha.find('=');
+        if (igual == std::string::npos) {
+            throw std::runtime_error(caminho + ":" + std::to_string(n_linha) + ": esperava chave = valor");
+        }
+        parametros.definir(aparar(linha.substr(0, igual)), aparar(linha.substr(igual + 1)));
+    }
+}
+
+ParametrosExecucao ler_parametros(const int argc, char* argv[]) {
+    ParametrosExecucao parametros;
+    // o arquivo primeiro, independente de onde o --config estiver, para a linha de comando sempre ganhar
+    for (int i=1; i<argc; i++) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--config=", 0) == 0) ler_arquivo_config(arg.substr(9), parametros);
+    }
+    for (int i=1; i<argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--ajuda" || arg == "-h" || arg == "--help") {
+            parametros.ajuda = true;
+            continue;
+        }
+        const size_t igual = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || igual == std::string::npos) {
+            throw std::runtime_error("Opcao invalida: " + arg + " (use --chave=valor, --ajuda lista as chaves)");
+        }
+        const std::string chave = arg.substr(2, igual - 2);
+        if (chave == "config") continue;
+        parametros.definir(chave, arg.substr(igual + 1));
+    }
+    return parametros;
+}
+
+// "x:y:largura:altura" em células (com ':' porque a vírgula faria uma lista da varredura)
+static RegiaoPiramide ler_regiao(const std::string& chave, const std::string& valor) {
+    std::vector<int> numeros;
+    std::stringstream ss(valor);
+    std::string item;
+    while (std::getline(ss, item, ':')) numeros.push_back(ler_numero<int>(chave, aparar(item)));
+    if (numeros.size() != 4 || numeros[2] <= 0 || numeros[3] <= 0) {
+        throw std::runtime_error("Valor invalido para " + chave + " (use x:y:largura:altura): '" + valor + "'");
+    }
+    return {numeros[0], numeros[1], numeros[2], numeros[3]};
+}
+
+void aplicar_parametro(ConfigExecucao &config, const std::string &chave, const std::string &valor) {
+    ConfigColonia& colonia = config.colonia;
+
+    // Labirinto
+    if (chave == "largura") config.largura = ler_numero<int>(chave, valor);
+    else if (chave == "altura") config.altura = ler_numero<int>(chave, valor);
+    else if (chave == "algoritmo_labirinto") {
+        if (valor == "pilares") config.labirinto.algoritmo = AlgoritmoLabirinto::PILARES;
+        else if (valor == "pilares_dificil") config.labirinto.algoritmo = AlgoritmoLabirinto::PILARES_DIFICIL;
+        else if (valor == "backtracker") config.labirinto.algoritmo = AlgoritmoLabirinto::BACKTRACKER;
+        else if (valor == "kruskal") config.labirinto.algoritmo = AlgoritmoLabirinto::KRUSKAL;
+        else if (valor == "trancado") config.labirinto.algoritmo = AlgoritmoLabirinto::TRANCADO;
+        else throw std::runtime_error("Algoritmo de labirinto desconhecido: " + valor);
+    }
+    else if (chave == "semente_labirinto") config.labirinto.semente = ler_numero<std::uint64_t>(chave, valor);
+    else if (chave == "chance_parede_adicional") config.labirinto.chance_parede_adicional = ler_numero<int>(chave, valor);
+    else if (chave == "densidade_lacos") config.labirinto.densidade_lacos = ler_numero<double>(chave, valor);
+    else if (chave == "arquivo_labirinto") config.arquivo_labirinto = valor;
+    else if (chave == "salvar_labirinto") config.salvar_labirinto = valor;
+
+    // Colônia
+    else if (chave == "n_formigas") colonia.n_formigas = ler_positivo(chave, valor);
+    else if (chave == "alfa") colonia.alfa = ler_numero<double>(chave, valor);
+    else if (chave == "beta") colonia.beta = ler_numero<double>(chave, valor);
+    else if (chave == "taxa_evaporacao") colonia.taxa_evaporacao = ler_numero<double>(chave, valor);
+    else if (chave == "intensidade_feromonio") {
+        colonia.intensidade_feromonio = ler_numero<double>(chave, valor);
+        config.intensidade_automatica = false;
+    }
+    else if (chave == "min_feromonio") colonia.min_feromonio = ler_numero<double>(chave, valor);
+    else if (chave == "max_passos_timeout") colonia.max_passos_timeout = ler_numero<int>(chave, valor);
+    else if (chave == "elite") colonia.elite = ler_numero<int>(chave, valor);
+    else if (chave == "semente") colonia.semente = ler_numero<std::uint64_t>(chave, valor);
+    else if (chave == "cache_feromonio_alfa") colonia.cache_feromonio_alfa = ler_booleano(chave, valor);
+    else if (chave == "modo_visitados") {
+        if (valor == "automatico") colonia.modo_visitados = ModoVisitados::AUTOMATICO;
+        else if (valor == "denso") colonia.modo_visitados = ModoVisitados::DENSO;
+        else if (valor == "esparso") colonia.modo_visitados = ModoVisitados::ESPARSO;
+        else throw std::runtime_error("Modo de visitados desconhecido: " + valor);
+    }
+    else if (chave == "poda") {
+        if (valor == "desligada") colonia.poda = ModoPoda::DESLIGADA;
+        else if (valor == "entre_iteracoes") colonia.poda = ModoPoda::ENTRE_ITERACOES;
+        else if (valor == "imediata") colonia.poda = ModoPoda::IMEDIATA;
+        else throw std::runtime_error("Poda desconhecida: " + valor);
+    }
+    else if (chave == "motor") {
+        if (valor == "escalar") colonia.motor = MotorFormigas::ESCALAR;
+        else if (valor == "lote") colonia.motor = MotorFormigas::LOTE;
+        else if (valor == "lote_sem_simd") colonia.motor = MotorFormigas::LOTE_SEM_SIMD;
+        else throw std::runtime_error("Motor desconhecido: " + valor);
+    }
+    else if (chave == "encurtar_caminhos") colonia.encurtar_caminhos = ler_booleano(chave, valor);
+    else if (chave == "raio_religacao") colonia.raio_religacao = ler_numero<int>(chave, valor);
+    else if (chave == "raio_reparo") colonia.raio_reparo = ler_numero<int>(chave, valor);
+    else if (chave == "mmas_p_melhor") colonia.mmas_p_melhor = ler_numero<double>(chave, valor);
+    else if (chave == "mmas_intervalo_global") colonia.mmas_intervalo_global = ler_numero<int>(chave, valor);
+    else if (chave == "acs_q0") colonia.acs_q0 = ler_numero<double>(chave, valor);
+    else if (chave == "acs_taxa_local") colonia.acs_taxa_local = ler_numero<double>(chave, valor);
+    else if (chave == "variante") {
+        if (valor == "elitista") config.variante = VarianteAco::ELITISTA;
+        else if (valor == "mmas") config.variante = VarianteAco::MMAS;
+        else if (valor == "acs") config.variante = VarianteAco::ACS;
+        else if (valor == "rank") config.variante = VarianteAco::RANK;
+        else throw std::runtime_error("Variante desconhecida: " + valor);
+    }
+    else if (chave == "evaporacao_preguicosa") config.evaporacao_preguicosa = ler_booleano(chave, valor);
+    else if (chave == "usar_grafo_juncoes") config.usar_grafo_juncoes = ler_booleano(chave, valor);
+
+    // Ilhas
+    else if (chave == "n_ilhas") config.ilhas.n_ilhas = ler_numero<int>(chave, valor);
+    else if (chave == "intervalo_migracao") config.ilhas.intervalo_migracao = ler_positivo(chave, valor);
+    else if (chave == "topologia_ilhas") {
+        if (valor == "anel") config.ilhas.topologia = TopologiaIlhas::ANEL;
+        else if (valor == "completa") config.ilhas.topologia = TopologiaIlhas::COMPLETA;
+        else throw std::runtime_error("Topologia desconhecida: " + valor);
+    }
+    else if (chave == "migracao_ilhas") {
+        if (valor == "melhor_caminho") config.ilhas.migracao = MigracaoIlhas::MELHOR_CAMINHO;
+        else if (valor == "mistura_feromonio") config.ilhas.migracao = MigracaoIlhas::MISTURA_FEROMONIO;
+        else throw std::runtime_error("Migracao desconhecida: " + valor);
+    }
+
+    // Execução
+    else if (chave == "n_iteracoes") config.n_iteracoes = ler_numero<int>(chave, valor);
+    else if (chave == "parada_por_estagnacao") config.parada_por_estagnacao = ler_numero<int>(chave, valor);
+    else if (chave == "salvar_iteracao") config.salvar_iteracao = ler_positivo(chave, valor);
+    else if (chave == "imprimir_iteracao") config.imprimir_iteracao = ler_positivo(chave, valor);
+    else if (chave == "nivel_snapshot") config.nivel_snapshot = ler_numero<int>(chave, valor);
+    else if (chave == "regiao_snapshot") config.regiao_snapshot = ler_regiao(chave, valor);
+    else if (chave == "checkpoint") config.checkpoint = valor;
+    else if (chave == "intervalo_checkpoint") config.intervalo_checkpoint = ler_positivo(chave, valor);
+    else if (chave == "retomar") config.retomar = valor;
+    else if (chave == "threads") config.threads = ler_numero<int>(chave, valor);
+    else if (chave == "saida_varredura") config.saida_varredura = valor;
+    else throw std::runtime_error("Chave desconhecida: " + chave + " (--ajuda lista as chaves)");
+}
+
+// dentro é a conta do intervalo, escrita de um jeito que NaN dá false
+static void exigir_intervalo(const bool dentro, const std::string& chave, const double valor,
+                             const std::string& intervalo) {
+    if (dentro) return;
+    std::ostringstream mensagem;
+    mensagem << chave << " tem que estar em " << intervalo << ", veio " << valor;
+    throw std::runtime_error(mensagem.str());
+}
+
+// Os intervalos e o que depende de mais de uma chave (a ordem em que elas aparecem não importa, então só dá pra ver
+// no final)
+static void validar_config(const ConfigExecucao& config) {
+    const ConfigColonia& colonia = config.colonia;
+    exigir_intervalo(colonia.alfa >= 0.0, "alfa", colonia.alfa, "[0, inf)");
+    exigir_intervalo(colonia.beta >= 0.0, "beta", colonia.beta, "[0, inf)");
+    // acima de 1 o fator de evaporação fica negativo (e a PREGUICOSA deixa de bater com a IMEDIATA)
+    exigir_intervalo(colonia.taxa_evaporacao > 0.0 && colonia.taxa_evaporacao <= 1.0, "taxa_evaporacao",
+                     colonia.taxa_evaporacao, "(0, 1]");
+    // o tau_min do MMAS usa p_melhor^(1/n): com 0 ou 1 a fórmula degenera
+    exigir_intervalo(colonia.mmas_p_melhor > 0.0 && colonia.mmas_p_melhor < 1.0, "mmas_p_melhor",
+                     colonia.mmas_p_melhor, "(0, 1)");
+    exigir_intervalo(colonia.acs_q0 >= 0.0 && colonia.acs_q0 <= 1.0, "acs_q0", colonia.acs_q0, "[0, 1]");
+    exigir_intervalo(colonia.acs_taxa_local >= 0.0 && colonia.acs_taxa_local <= 1.0, "acs_taxa_local",
+                     colonia.acs_taxa_local, "[0, 1]");
+    if (config.variante == VarianteAco::ELITISTA && config.colonia.elite < 1) {
+        throw std::runtime_error("elite tem que ser >= 1 na variante elitista (nenhuma formiga depositaria)");
+    }
+    // a ColoniaGrafo é só elitista e não tem ilhas: em vez de ignorar uma das chaves sem avisar, dá erro
+    if (config.usar_grafo_juncoes && config.variante != VarianteAco::ELITISTA) {
+        throw std::runtime_error("usar_grafo_juncoes so roda a variante elitista");
+    }
+    if (config.usar_grafo_juncoes && config.ilhas.n_ilhas > 1) {
+        throw std::runtime_error("usar_grafo_juncoes nao roda o modelo de ilhas (n_ilhas > 1)");
+    }
+}
+
+GradeVarredura montar_grade(const ParametrosExecucao &parametros) {
+    GradeVarredura grade;
+    ConfigExecucao base;
+    // os valores únicos vão direto na base, as listas ficam para o produto cartesiano
+    std::vector<const std::pair<std::string, std::vector<std::string>>*> listas;
+    for (const auto& parametro : parametros.valores) {
+        const auto& [chave, itens] = parametro;
+        if (itens.size() == 1) {
+            aplicar_parametro(base, chave, itens[0]);
+            continue;
+        }
+        if (std::ranges::find(CHAVES_LABIRINTO, chave) != CHAVES_LABIRINTO.end()
+            || std::ranges::find(CHAVES_GLOBAIS, chave) != CHAVES_GLOBAIS.end()) {
+            throw std::runtime_error("A chave " + chave + " nao pode variar na varredura (o labirinto e um so)");
+        }
+        for (const std::string& item : itens) { // confere os valores antes de rodar qualquer coisa
+            ConfigExecucao teste;
+            aplicar_parametro(teste, chave, item);
+        }
+        grade.chaves.push_back(chave);
+        listas.push_back(&parametro);
+    }
+
+    // contador com um dígito por lista, o último gira mais rápido
+    std::vector<size_t> atual(listas.size(), 0);
+    while (true) {
+        ConfigExecucao config = base;
+        std::vector<std::string> valores;
+        for (size_t k=0; k<listas.size(); k++) {
+            const std::string& valor = listas[k]->second[atual[k]];
+            aplicar_parametro(config, listas[k]->first, valor);
+            valores.push_back(valor);
+        }
+        config.ilhas.parada_por_estagnacao = config.parada_por_estagnacao;
+        validar_config(config);
+        grade.configs.push_back(std::move(config));
+        grade.valores.push_back(std::move(valores));
+
+        size_t k = listas.size();
+        while (k > 0 && ++atual[k-1] == listas[k-1]->second.size()) {
+            atual[k-1] = 0;
+            k--;
+        }
+        if (k == 0) break;
+    }
+    return grade;
+}
+
+void ajustar_ao_labirinto(GradeVarredura &grade, const Labirinto &lab) {
+    for (ConfigExecucao& config : grade.configs) {
+        config.largura = lab.get_largura();
+        config.altura = lab.get_altura();
+        if (config.intensidade_automatica) {
+            config.colonia.intensidade_feromonio = config.largura * config.altura * 0.1;
+        }
+    }
+}
+
+void imprimir_ajuda(std::ostream &out) {
+    out << "Uso: ACO_Labirinto [--config=arquivo] [--chave=valor ...]\n"
+           "O arquivo tem uma 'chave = valor' por linha (# comenta). A linha de comando passa por cima do arquivo.\n"
+           "Uma lista (--alfa=0.5,1,2) liga a varredura: todas as combinacoes das listas rodam ao mesmo tempo no\n"
+           "mesmo labirinto, e cada uma vira uma linha em saida_varredura.\n\n"
+           "Labirinto (sem lista):\n"
+           "  largura, altura                         150, 150\n"
+           "  algoritmo_labirinto                     pilares|pilares_dificil|backtracker|kruskal|trancado\n"
+           "  semente_labirinto                       2024\n"
+           "  chance_parede_adicional                 20 (pilares_dificil, em %)\n"
+           "  densidade_lacos                         0.25 (trancado)\n"
+           "  arquivo_labirinto                       carrega deste arquivo em vez de gerar\n"
+           "  salvar_labirinto                        salva o labirinto neste arquivo\n"
+           "Colonia:\n"
+           "  variante                                elitista|mmas|acs|rank\n"
+           "  n_formigas, alfa, beta                  100, 1, 4\n"
+           "  taxa_evaporacao, min_feromonio          0.35, 0.01\n"
+           "  intensidade_feromonio                   largura*altura*0.1\n"
+           "  max_passos_timeout                      0 (= 2*largura*altura)\n"
+           "  elite, semente                          5, 42\n"
+           "  poda                                    desligada|entre_iteracoes|imediata\n"
+           "  motor                                   escalar|lote|lote_sem_simd\n"
+           "  encurtar_caminhos, raio_religacao       0, 0 (encurta a elite; raio > 0 religa por BFS)\n"
+           "  raio_reparo                             16 (labirinto dinamico)\n"
+           "  cache_feromonio_alfa                    0\n"
+           "  modo_visitados                          automatico|denso|esparso\n"
+           "  mmas_p_melhor, mmas_intervalo_global    0.05, 5\n"
+           "  acs_q0, acs_taxa_local                  0.9, 0.1\n"
+           "  evaporacao_preguicosa                   0\n"
+           "  usar_grafo_juncoes                      0 (so elitista, sem ilhas)\n"
+           "  n_ilhas, intervalo_migracao             1, 10 (n_ilhas > 1 nao vale na varredura)\n"
+           "  topologia_ilhas                         anel|completa\n"
+           "  migracao_ilhas                          melhor_caminho|mistura_feromonio\n"
+           "Execucao:\n"
+           "  n_iteracoes, parada_por_estagnacao      350, 35 (-1 desativa a parada)\n"
+           "  salvar_iteracao, imprimir_iteracao      2, 10\n"
+           "  nivel_snapshot                          0 (blocos de 2^nivel x 2^nivel, maximo e media)\n"
+           "  regiao_snapshot                         x:y:largura:altura (padrao: o labirinto inteiro)\n"
+           "  checkpoint, intervalo_checkpoint        (nenhum), 50\n"
+           "  retomar                                 continua do checkpoint deste arquivo\n"
+           "  threads                                 0 (= padrao do OpenMP)\n"
+           "  saida_varredura                         ../visualizacao/varredura.csv\n";
+}
@@ -0,0 +1,96 @@
+#ifndef ACO_LABIRINTO_CONFIGURACAO_H
+#define ACO_LABIRINTO_CONFIGURACAO_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Arquipelago.h"
+#include "Colonia.h"
+#include "GeradorLabirinto.h"
+
+// Variante do ACO (PoliticasAco.h). Escolhida em tempo de execução, mas cada uma vira o seu tipo de colônia
+// (Colonia, ColoniaMMAS, ColoniaACS, ColoniaRank) logo no começo, então o passo das formigas continua sem nenhuma
+// chamada virtual
+enum class VarianteAco { ELITISTA, MMAS, ACS, RANK };
+
+// Tudo que o main.cpp tinha como constexpr. Os valores padrão são os mesmos de antes, então rodar sem nenhum
+// parâmetro dá o mesmo resultado
+struct ConfigExecucao {
+    // Labirinto: numa varredura é um só para todas as configurações, então estes não podem ter lista
+    int largura = 150;
+    int altura = 150;
+    // PILARES_DIFICIL: a chance de ser gerada uma parede é de 20% para cada chão adjacente a um pilar, e gera de novo
+    // até ter solução. Os outros geradores estão no GeradorLabirinto.h
+    ConfigLabirinto labirinto{.algoritmo = AlgoritmoLabirinto::PILARES_DIFICIL, .semente = 2024};
+    // Se tiver, o labirinto vem deste arquivo (ArquivoLabirinto.h) e os campos acima são ignorados
+    std::string arquivo_labirinto;
+    std::string salvar_labirinto; // se tiver, salva o labirinto usado neste arquivo antes de rodar
+
+    // Hiperparâmetros da colônia (o intensidade_feromonio é largura*altura*0.1 se não for dado)
+    ConfigColonia colonia;
+    bool intensidade_automatica = true;
+    VarianteAco variante = VarianteAco::ELITISTA;
+    // Evapora só quando a célula é lida/recebe depósito (mesmos valores, mas não percorre o labirinto inteiro toda
+    // iteração). false = evaporação imediata, a de referência
+    bool evaporacao_preguicosa = false;
+    // As formigas andam no grafo de junções (corredores viram uma aresta só), só decidindo nas bifurcações
+    bool usar_grafo_juncoes = false;
+    // n_ilhas > 1 liga o modelo de ilhas (Arquipelago.h). A parada por estagnação das ilhas é a de baixo
+    ConfigIlhas ilhas{.n_ilhas = 1};
+
+    int n_iteracoes = 350;
+    int parada_por_estagnacao = 35; // quantas iterações sem melhora para parar, -1 para desativar
+    int salvar_iteracao = 2; // de quantas em quantas iterações vai um snapshot para ../visualizacao/snapshots.bin
+    int imprimir_iteracao = 10; // de quantas em quantas iterações mostra o progresso no terminal
+    // Labirinto grande: os snapshots podem levar só um nível da pirâmide do feromônio (PiramideFeromonio.h, blocos
+    // de 2^nivel x 2^nivel) e/ou só uma região de células. 0 e sem região = o labirinto inteiro, célula a célula
+    int nivel_snapshot = 0;
+    RegiaoPiramide regiao_snapshot;
+
+    // Checkpoint (Checkpoint.h): se tiver arquivo, o estado inteiro vai para ele a cada intervalo_checkpoint
+    // iterações, escrito em outra thread. retomar = um checkpoint de uma execução com a mesma configuração, que
+    // continua de onde ele parou dando o mesmo resultado. Só na execução normal (sem ilhas, grafo ou varredura)
+    std::string checkpoint;
+    int intervalo_checkpoint = 50;
+    std::string retomar;
+
+    int threads = 0; // threads do OpenMP, 0 = o padrão (OMP_NUM_THREADS ou todos os núcleos)
+    std::string saida_varredura = "../visualizacao/varredura.csv"; // uma linha por configuração
+};
+
+// Os parâmetros ainda em texto, como vieram do arquivo e da linha de comando. Uma chave com lista (alfa=0.5,1,2)
+// vira uma dimensão da varredura
+struct ParametrosExecucao {
+    std::vector<std::pair<std::string, std::vector<std::string>>> valores; // na ordem em que apareceram
+    bool ajuda = false;
+
+    // Troca a lista da chave se ela já existir (a linha de comando passa por cima do arquivo)
+    void definir(const std::string& chave, const std::string& lista);
+};
+
+// O produto cartesiano de todas as listas. Sem nenhuma lista é uma configuração só e chaves fica vazio
+struct GradeVarredura {
+    std::vector<std::string> chaves; // as chaves que variam, na ordem das colunas do resumo
+    std::vector<ConfigExecucao> configs; // a última chave é a que varia mais rápido
+    std::vector<std::vector<std::string>> valores; // valores[i][k] = valor de chaves[k] em configs[i]
+};
+
+// Arquivo de configuração: uma "chave = valor" por linha, # começa comentário. As chaves são os nomes que estão no
+// imprimir_ajuda (os mesmos das antigas constantes do main.cpp, em minúsculas)
+void ler_arquivo_config(const std::string& caminho, ParametrosExecucao& parametros);
+// --config=arquivo é lido primeiro, depois cada --chave=valor passa por cima. --ajuda só marca parametros.ajuda
+[[nodiscard]] ParametrosExecucao ler_parametros(int argc, char* argv[]);
+// Joga uma chave (com um valor só) na configuração. Chave ou valor inválido dá runtime_error
+void aplicar_parametro(ConfigExecucao& config, const std::string& chave, const std::string& valor);
+[[nodiscard]] GradeVarredura montar_grade(const ParametrosExecucao& parametros);
+// O que depende do labirinto já criado: largura/altura (de um labirinto carregado) e o intensidade_feromonio
+// automático
+void ajustar_ao_labirinto(GradeVarredura& grade, const Labirinto& lab);
+
+void imprimir_ajuda(std::ostream& out);
+
+
+#endif //ACO_LABIRINTO_CONFIGURACAO_H
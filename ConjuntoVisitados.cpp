@@ -0,0 +1,93 @@
+#include "ConjuntoVisitados.h"
+#include <algorithm>
+
+constexpr int BITS_TABELA_INICIAL = 8; // 256 posições
+
+ConjuntoVisitados::ConjuntoVisitados(const int n_celulas, const ModoVisitados modo) {
+    this->modo = modo;
+    if (this->modo == ModoVisitados::AUTOMATICO) {
+        this->modo = n_celulas >= LIMIAR_VISITADOS_ESPARSO ? ModoVisitados::ESPARSO : ModoVisitados::DENSO;
+    }
+
+    if (this->modo == ModoVisitados::DENSO) {
+        carimbos.assign(n_celulas, 0);
+    }
+    else {
+        bits_tabela = BITS_TABELA_INICIAL;
+        tabela.assign(std::size_t{1} << bits_tabela, VAZIO);
+    }
+}
+
+void ConjuntoVisitados::limpar() {
+    if (modo == ModoVisitados::DENSO) {
+        epoca++;
+        if (epoca == 0) { // deu a volta no uint16, aí sim precisa zerar tudo
+            std::ranges::fill(carimbos, 0);
+            epoca = 1;
+        }
+        return;
+    }
+
+    for (const std::uint32_t posicao : posicoes_ocupadas) {
+        tabela[posicao] = VAZIO;
+    }
+    posicoes_ocupadas.clear();
+}
+
+void ConjuntoVisitados::marcar(const int indice) {
+    if (modo == ModoVisitados::DENSO) {
+        carimbos[indice] = epoca;
+        return;
+    }
+
+    // mantém a tabela no máximo meio cheia, assim a sondagem linear fica curta
+    if ((posicoes_ocupadas.size() + 1) * 2 > tabela.size()) crescer_tabela();
+
+    const std::uint32_t mascara = static_cast<std::uint32_t>(tabela.size()) - 1;
+    std::uint32_t posicao = posicao_inicial(indice);
+    while (tabela[posicao] != VAZIO) {
+        if (tabela[posicao] == indice) return;
+        posicao = (posicao + 1) & mascara;
+    }
+    tabela[posicao] = indice;
+    posicoes_ocupadas.push_back(posicao);
+}
+
+bool ConjuntoVisitados::contem(const int indice) const {
+    if (modo == ModoVisitados::DENSO) {
+        return carimbos[indice] == epoca;
+    }
+
+    const std::uint32_t mascara = static_cast<std::uint32_t>(tabela.size()) - 1;
+    std::uint32_t posicao = posicao_inicial(indice);
+    while (tabela[posicao] != VAZIO) {
+        if (tabela[posicao] == indice) return true;
+        posicao = (posicao + 1) & mascara;
+    }
+    return false;
+}
+
+void ConjuntoVisitados::crescer_tabela() {
+    std::vector<std::int32_t> antigos;
+    antigos.reserve(posicoes_ocupadas.size());
+    for (const std::uint32_t posicao : posicoes_ocupadas) {
+        antigos.push_back(tabela[posicao]);
+    }
+
+    bits_tabela++;
+    tabela.assign(std::size_t{1} << bits_tabela, VAZIO);
+    posicoes_ocupadas.clear();
+    for (const std::int32_t indice : antigos) {
+        marcar(indice);
+    }
+}
+
+ModoVisitados ConjuntoVisitados::get_modo() const {
+    return modo;
+}
+
+std::size_t ConjuntoVisitados::bytes_usados() const {
+    return carimbos.capacity() * sizeof(std::uint16_t)
+        + tabela.capacity() * sizeof(std::int32_t)
+        + posicoes_ocupadas.capacity() * sizeof(std::uint32_t);
+}
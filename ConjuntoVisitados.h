@@ -0,0 +1,49 @@
+#ifndef ACO_LABIRINTO_CONJUNTOVISITADOS_H
+#define ACO_LABIRINTO_CONJUNTOVISITADOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// DENSO: um carimbo de 16 bits por célula do labirinto. limpar() só incrementa a "época" atual, então o reset da
+// formiga é O(1) (a cada 65535 resets o vetor é zerado de verdade).
+// ESPARSO: tabela hash com endereçamento aberto, só guarda as células visitadas. Memória e limpeza proporcionais
+// ao caminho, bom para labirintos enormes em que a formiga só passa por uma fração pequena das células.
+// AUTOMATICO: escolhe ESPARSO a partir de LIMIAR_VISITADOS_ESPARSO células
+enum class ModoVisitados { DENSO, ESPARSO, AUTOMATICO };
+
+constexpr std::int64_t LIMIAR_VISITADOS_ESPARSO = 4'000'000; // ~2000x2000
+
+class ConjuntoVisitados {
+public:
+    ConjuntoVisitados(int n_celulas, ModoVisitados modo);
+
+    void limpar();
+    void marcar(int indice);
+    [[nodiscard]] bool contem(int indice) const;
+
+    [[nodiscard]] ModoVisitados get_modo() const;
+    [[nodiscard]] std::size_t bytes_usados() const;
+
+private:
+    ModoVisitados modo;
+
+    // DENSO
+    std::vector<std::uint16_t> carimbos;
+    std::uint16_t epoca = 1;
+
+    // ESPARSO
+    static constexpr std::int32_t VAZIO = -1;
+    std::vector<std::int32_t> tabela;
+    std::vector<std::uint32_t> posicoes_ocupadas; // para limpar só o que foi usado
+    int bits_tabela = 0; // tabela tem 2^bits_tabela posições
+
+    [[nodiscard]] std::uint32_t posicao_inicial(const int indice) const {
+        // hash de Fibonacci: multiplica pela razão áurea e pega os bits mais altos
+        return (static_cast<std::uint32_t>(indice) * 2654435769u) >> (32 - bits_tabela);
+    }
+    void crescer_tabela();
+};
+
+
+#endif //ACO_LABIRINTO_CONJUNTOVISITADOS_H
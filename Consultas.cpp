@@ -0,0 +1,100 @@
+#include "Consultas.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template<class ColoniaT>
+static void resolver(ColoniaT& colonia, const ConfigConsultas& config_consultas, ResultadoConsulta& resultado) {
+    const auto inicio = std::chrono::steady_clock::now();
+    resultado.melhor_por_iteracao.reserve(config_consultas.n_iteracoes);
+    int estagnacao = 0;
+    while (resultado.iteracoes < config_consultas.n_iteracoes) {
+        const ResultadoIteracao iteracao = colonia.iterar();
+        resultado.iteracoes++;
+        resultado.melhor_por_iteracao.push_back(colonia.get_menor_tamanho_global());
+        if (iteracao.melhorou_global) {
+            estagnacao = 0;
+            resultado.iteracao_melhor = resultado.iteracoes;
+        }
+        else estagnacao++;
+        if (config_consultas.parada_por_estagnacao != -1 && estagnacao >= config_consultas.parada_por_estagnacao) {
+            break;
+        }
+    }
+    resultado.melhor = colonia.get_menor_tamanho_global();
+    resultado.melhor_caminho = colonia.get_melhor_caminho_global();
+    resultado.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+template<class ColoniaT>
+std::vector<ResultadoConsulta> resolver_consultas(const Labirinto &base, const std::vector<Consulta> &consultas,
+                                                  const ConfigColonia &config,
+                                                  const ConfigConsultas &config_consultas) {
+    // confere tudo antes de começar (o get_valor_grid já reclama de posição fora do labirinto)
+    for (const Consulta& consulta : consultas) {
+        if (base.get_valor_grid(consulta.ninho) == 1 || base.get_valor_grid(consulta.comida) == 1) {
+            throw std::runtime_error("Ninho ou comida em cima de uma parede!");
+        }
+    }
+
+    const int n = static_cast<int>(consultas.size());
+    std::vector<ResultadoConsulta> resultados(n);
+
+    // agrupadas pela comida (a heurística só depende dela), o resto na ordem original
+    std::vector<int> ordem(n);
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::ranges::stable_sort(ordem, [&consultas](const int a, const int b) {
+        const Pos& ca = consultas[a].comida;
+        const Pos& cb = consultas[b].comida;
+        return ca.x != cb.x ? ca.x < cb.x : ca.y < cb.y;
+    });
+
+#ifdef _OPENMP
+    const int threads = config_consultas.threads > 0 ? config_consultas.threads : omp_get_max_threads();
+#endif
+    std::exception_ptr erro;
+    #pragma omp parallel num_threads(threads)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(1); // vale só para esta thread: a colônia não abre outro time
+#endif
+        Labirinto lab = base;
+        // uma colônia por thread, criada na primeira consulta e reiniciada nas outras: as formigas e os visitados
+        // (largura*altura por formiga) são alocados uma vez só
+        std::unique_ptr<ColoniaT> colonia;
+        #pragma omp for schedule(dynamic, 1)
+        for (int k=0; k<n; k++) {
+            const int i = ordem[k];
+            try {
+                lab.set_ninho_comida(consultas[i].ninho, consultas[i].comida);
+                lab.reiniciar_feromonios(); // a consulta anterior desta thread (ou a base) não pode vazar
+                if (!colonia) colonia = std::make_unique<ColoniaT>(lab, config);
+                else colonia->reiniciar();
+                resolver(*colonia, config_consultas, resultados[i]);
+            } catch (...) {
+                // exceção não pode sair do bloco paralelo, guarda a primeira e joga depois
+                #pragma omp critical(aco_consultas_erro)
+                if (!erro) erro = std::current_exception();
+            }
+        }
+    }
+    if (erro) std::rethrow_exception(erro);
+    return resultados;
+}
+
+// As mesmas variantes do Colonia.cpp
+template std::vector<ResultadoConsulta> resolver_consultas<Colonia>(
+    const Labirinto&, const std::vector<Consulta>&, const ConfigColonia&, const ConfigConsultas&);
+template std::vector<ResultadoConsulta> resolver_consultas<ColoniaMMAS>(
+    const Labirinto&, const std::vector<Consulta>&, const ConfigColonia&, const ConfigConsultas&);
+template std::vector<ResultadoConsulta> resolver_consultas<ColoniaACS>(
+    const Labirinto&, const std::vector<Consulta>&, const ConfigColonia&, const ConfigConsultas&);
+template std::vector<ResultadoConsulta> resolver_consultas<ColoniaRank>(
+    const Labirinto&, const std::vector<Consulta>&, const ConfigColonia&, const ConfigConsultas&);
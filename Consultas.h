@@ -0,0 +1,46 @@
+#ifndef ACO_LABIRINTO_CONSULTAS_H
+#define ACO_LABIRINTO_CONSULTAS_H
+
+#include <vector>
+
+#include "CaminhoCompacto.h"
+#include "Colonia.h"
+#include "Labirinto.h"
+
+// Um par (ninho, comida) a resolver no labirinto
+struct Consulta {
+    Pos ninho, comida;
+};
+
+struct ConfigConsultas {
+    int n_iteracoes = 200;
+    int parada_por_estagnacao = 35; // iterações sem melhora para parar a consulta, -1 desativa
+    int threads = 0; // quantas consultas ao mesmo tempo, 0 = o padrão do OpenMP
+};
+
+struct ResultadoConsulta {
+    CaminhoCompacto melhor_caminho; // vazio = nenhuma formiga chegou na comida
+    int melhor = -1;
+    int iteracao_melhor = -1; // em que iteração o melhor apareceu (começando do 1)
+    int iteracoes = 0;
+    std::vector<int> melhor_por_iteracao; // convergência: o melhor global depois de cada iteração (-1 = nenhum ainda)
+    double segundos = 0.0;
+};
+
+// Resolve um lote de consultas no mesmo labirinto, cada uma com uma colônia ColoniaT do zero e o mesmo config.
+// As threads do OpenMP funcionam como um pool: cada uma tem um Labirinto só (cópia da base, paredes
+// compartilhadas) e uma ColoniaT só, e vai pegando a próxima consulta da fila, trocando o ninho/comida, zerando o
+// feromônio e reiniciando a colônia (ColoniaAco::reiniciar, sem alocar as formigas de novo). As
+// consultas são atendidas agrupadas pela comida, então quem pega várias seguidas com a mesma comida reaproveita a
+// tabela da heurística. Cada colônia roda com 1 thread, o paralelismo é entre consultas.
+// O resultado de cada consulta não depende de quantas threads rodaram nem da ordem (a semente é a do config).
+// Consulta fora do labirinto ou em parede dá runtime_error antes de começar; par sem caminho entre eles só
+// termina sem solução (melhor = -1) pela estagnação ou pelo n_iteracoes
+template<class ColoniaT>
+[[nodiscard]] std::vector<ResultadoConsulta> resolver_consultas(const Labirinto& base,
+                                                                const std::vector<Consulta>& consultas,
+                                                                const ConfigColonia& config,
+                                                                const ConfigConsultas& config_consultas);
+
+
+#endif //ACO_LABIRINTO_CONSULTAS_H
@@ -0,0 +1,174 @@
+#include "EncurtadorCaminho.h"
+#include <algorithm>
+
+constexpr int DX[4] = {-1, 1, 0, 0};
+constexpr int DY[4] = {0, 0, -1, 1};
+
+EncurtadorCaminho::EncurtadorCaminho(const Labirinto &labirinto, const int raio_religacao)
+    :   lab(labirinto),
+        raio_religacao(raio_religacao)
+{
+}
+
+void EncurtadorCaminho::encurtar(std::vector<Pos> &caminho) {
+    if (caminho.size() < 3) return;
+
+    atalhos_por_vizinhos(caminho);
+    // a religação pode passar por células que já estavam no caminho, a segunda passada tira esses laços
+    if (raio_religacao > 0 && religar_por_bfs(caminho)) atalhos_por_vizinhos(caminho);
+}
+
+void EncurtadorCaminho::indexar(const std::vector<Pos> &caminho) {
+    ultimo_indice.clear();
+    ultimo_indice.reserve(caminho.size());
+    for (int i=0; i<static_cast<int>(caminho.size()); i++) ultimo_indice[lab.indice(caminho[i])] = i;
+}
+
+void EncurtadorCaminho::atalhos_por_vizinhos(std::vector<Pos> &caminho) {
+    indexar(caminho);
+    const int n = static_cast<int>(caminho.size());
+
+    saida.clear();
+    int i = 0;
+    while (true) {
+        saida.push_back(caminho[i]);
+        if (i == n-1) break;
+
+        // a própria célula repetida mais à frente também conta (laço)
+        int proximo = std::max(i + 1, ultimo_indice[lab.indice(caminho[i])] + 1);
+        for (int d=0; d<4; d++) {
+            const Pos v = {caminho[i].x + DX[d], caminho[i].y + DY[d]};
+            if (v.x < 0 || v.x >= lab.get_largura() || v.y < 0 || v.y >= lab.get_altura()) continue;
+
+            const auto it = ultimo_indice.find(lab.indice(v));
+            if (it != ultimo_indice.end() && it->second > proximo) proximo = it->second;
+        }
+        i = std::min(proximo, n-1);
+    }
+    caminho.swap(saida);
+}
+
+bool EncurtadorCaminho::religar_por_bfs(std::vector<Pos> &caminho) {
+    indexar(caminho);
+    const int n = static_cast<int>(caminho.size());
+    bool mudou = false;
+
+    saida.clear();
+    int i = 0;
+    while (i < n-1) {
+        const int origem = lab.indice(caminho[i]);
+
+        // BFS por camadas até raio_religacao, guardando de onde cada célula veio
+        pai_bfs.clear();
+        pai_bfs[origem] = -1;
+        fronteira.assign(1, origem);
+        int melhor_j = i + 1, melhor_ganho = 0, melhor_celula = -1;
+
+        for (int distancia=1; distancia<=raio_religacao && !fronteira.empty(); distancia++) {
+            proxima_fronteira.clear();
+            for (const int c : fronteira) {
+                const Pos p = {c / lab.get_altura(), c % lab.get_altura()};
+                for (int d=0; d<4; d++) {
+                    const Pos v = {p.x + DX[d], p.y + DY[d]};
+                    if (v.x < 0 || v.x >= lab.get_largura() || v.y < 0 || v.y >= lab.get_altura()) continue;
+                    if (lab.parede_rapida(v)) continue;
+
+                    const int iv = lab.indice(v);
+                    if (!pai_bfs.try_emplace(iv, c).second) continue; // já visitada
+                    proxima_fronteira.push_back(iv);
+
+                    const auto it = ultimo_indice.find(iv);
+                    if (it != ultimo_indice.end() && it->second > i) {
+                        const int ganho = (it->second - i) - distancia;
+                        if (ganho > melhor_ganho) {
+                            melhor_ganho = ganho;
+                            melhor_j = it->second;
+                            melhor_celula = iv;
+                        }
+                    }
+                }
+            }
+            fronteira.swap(proxima_fronteira);
+        }
+
+        saida.push_back(caminho[i]);
+        if (melhor_celula == -1) {
+            i++;
+            continue;
+        }
+
+        // o trecho novo sai da BFS de trás para frente (do ponto j até a origem, sem incluir os dois)
+        const size_t inicio_trecho = saida.size();
+        for (int c = pai_bfs[melhor_celula]; c != origem; c = pai_bfs[c]) {
+            saida.push_back({c / lab.get_altura(), c % lab.get_altura()});
+        }
+        std::reverse(saida.begin() + static_cast<long>(inicio_trecho), saida.end());
+        i = melhor_j;
+        mudou = true;
+    }
+    saida.push_back(caminho[n-1]);
+
+    if (mudou) caminho.swap(saida);
+    return mudou;
+}
+
+bool EncurtadorCaminho::reparar(std::vector<Pos> &caminho, const int raio) {
+    const int n = static_cast<int>(caminho.size());
+    if (std::ranges::none_of(caminho, [this](const Pos& p) { return lab.parede_rapida(p); })) return true;
+    if (n < 2 || lab.parede_rapida(caminho.front()) || lab.parede_rapida(caminho.back())) return false;
+    indexar(caminho);
+
+    saida.clear();
+    int i = 0;
+    while (true) {
+        saida.push_back(caminho[i]);
+        if (i == n-1) break;
+        if (!lab.parede_rapida(caminho[i+1])) {
+            i++;
+            continue;
+        }
+
+        // trecho bloqueado: BFS a partir daqui, o alvo é a célula livre do caminho com o maior índice
+        const int origem = lab.indice(caminho[i]);
+        pai_bfs.clear();
+        pai_bfs[origem] = -1;
+        fronteira.assign(1, origem);
+        int melhor_j = -1, melhor_celula = -1;
+
+        for (int distancia=1; distancia<=raio && !fronteira.empty(); distancia++) {
+            proxima_fronteira.clear();
+            for (const int c : fronteira) {
+                const Pos p = {c / lab.get_altura(), c % lab.get_altura()};
+                for (int d=0; d<4; d++) {
+                    const Pos v = {p.x + DX[d], p.y + DY[d]};
+                    if (v.x < 0 || v.x >= lab.get_largura() || v.y < 0 || v.y >= lab.get_altura()) continue;
+                    if (lab.parede_rapida(v)) continue;
+
+                    const int iv = lab.indice(v);
+                    if (!pai_bfs.try_emplace(iv, c).second) continue;
+                    proxima_fronteira.push_back(iv);
+
+                    const auto it = ultimo_indice.find(iv);
+                    if (it != ultimo_indice.end() && it->second > melhor_j && it->second > i + 1) {
+                        melhor_j = it->second;
+                        melhor_celula = iv;
+                    }
+                }
+            }
+            fronteira.swap(proxima_fronteira);
+        }
+        if (melhor_celula == -1) return false;
+
+        const size_t inicio_trecho = saida.size();
+        for (int c = pai_bfs[melhor_celula]; c != origem; c = pai_bfs[c]) {
+            saida.push_back({c / lab.get_altura(), c % lab.get_altura()});
+        }
+        std::reverse(saida.begin() + static_cast<long>(inicio_trecho), saida.end());
+        i = melhor_j;
+    }
+
+    caminho.swap(saida);
+    // o desvio pode cruzar o próprio caminho
+    atalhos_por_vizinhos(caminho);
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef ACO_LABIRINTO_ENCURTADORCAMINHO_H
+#define ACO_LABIRINTO_ENCURTADORCAMINHO_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "Labirinto.h"
+
+// Pós-processamento dos caminhos da elite antes do depósito. O caminho da formiga já vem sem os becos (o
+// backtracking tira eles da pilha), mas ainda pode dar voltas: passar do lado de uma célula que ela só visita
+// bem depois, ou contornar um pilar que tinha um atalho do outro lado.
+// Os vetores ficam guardados no objeto e são reaproveitados entre as chamadas
+class EncurtadorCaminho {
+public:
+    // raio_religacao = 0 desliga a religação por BFS (só faz a passada de vizinhos)
+    EncurtadorCaminho(const Labirinto& labirinto, int raio_religacao);
+
+    // Encurta o caminho no lugar. O resultado continua indo do mesmo início ao mesmo fim, só por células livres e
+    // vizinhas entre si, e sem repetir célula
+    void encurtar(std::vector<Pos>& caminho);
+
+    // Conserta um caminho que ficou passando por parede (labirinto dinâmico): em cada trecho bloqueado faz uma BFS
+    // de até raio passos a partir da última célula livre e emenda no ponto mais à frente do caminho que ela
+    // alcançar. Retorna false (e não mexe no caminho) se algum trecho não tem desvio dentro do raio
+    [[nodiscard]] bool reparar(std::vector<Pos>& caminho, int raio);
+
+private:
+    const Labirinto& lab;
+    int raio_religacao;
+
+    std::unordered_map<int, int> ultimo_indice; // célula -> última posição dela no caminho
+    std::unordered_map<int, int> pai_bfs; // célula -> célula de onde a BFS chegou nela
+    std::vector<int> fronteira, proxima_fronteira;
+    std::vector<Pos> saida;
+
+    void indexar(const std::vector<Pos>& caminho);
+    // De cada célula pula para o vizinho (ou a própria célula repetida) que aparece mais para frente no caminho.
+    // Tira os laços e os desvios de uma célula só
+    void atalhos_por_vizinhos(std::vector<Pos>& caminho);
+    // BFS de até raio_religacao passos a partir de cada ponto do caminho; se ela alcança um ponto mais à frente
+    // com menos passos do que o caminho gastava, troca o trecho. Retorna se mudou alguma coisa
+    bool religar_por_bfs(std::vector<Pos>& caminho);
+};
+
+
+#endif //ACO_LABIRINTO_ENCURTADORCAMINHO_H
@@ -1,64 +1,142 @@
 #include "Formiga.h"
 #include <cmath>
-#include <numeric>
 #include <algorithm>
+#include <random>
+#include <type_traits>
 
 
 
-Formiga::Formiga(Labirinto &labirinto, const double alfa, const double beta)
+Formiga::Formiga(Labirinto &labirinto, const double alfa, const double beta, const ModoVisitados modo_visitados)
     :   lab(labirinto),
         alfa(alfa),
         beta(beta),
+        tipo_alfa(classificar_expoente(alfa)),
+        tipo_beta(classificar_expoente(beta)),
         pos_ninho(lab.get_pos_ninho()),
         pos_comida(lab.get_pos_comida()),
+        visitados(labirinto.get_largura() * labirinto.get_altura(), modo_visitados),
         gen(std::random_device{}())
 {
-    matriz_exploracao.resize(labirinto.get_largura(), std::vector<bool>(lab.get_altura(), false));
+    lab.preparar_heuristica(beta);
     Formiga::reset();
 }
 
 void Formiga::reset() {
     m_encontrou_comida = false;
     m_fracassou = false;
+    m_podada = false;
     pos_atual = pos_ninho;
+    n_retrocessos = 0;
 
     // Limpa os vetores usados e joga a primeira variável neles
-    pilha_solucao.clear();
-    for(auto &coluna : matriz_exploracao) {
-        std::fill(coluna.begin(), coluna.end(), false);
+    pilha_solucao.reiniciar(pos_ninho);
+    visitados.limpar(); // O(1) no modo denso, proporcional ao último caminho no esparso
+    visitados.marcar(lab.indice(pos_ninho));
+}
+
+void Formiga::atualizar_ninho_comida() {
+    pos_ninho = lab.get_pos_ninho();
+    pos_comida = lab.get_pos_comida();
+    Formiga::reset();
+}
+
+void Formiga::semear(const std::uint64_t semente_mestre, const int id_formiga, const int iteracao) {
+    this->gen = GeradorAleatorio::para_fluxo(semente_mestre, id_formiga, iteracao);
+}
+
+// Chama f.operator()<A, B>() com os tipos do alfa e do beta como parâmetros de template
+template<TipoExpoente A, class F>
+static auto despachar_beta(const TipoExpoente tipo_beta, F&& f) {
+    switch (tipo_beta) {
+        case TipoExpoente::ZERO: return f.template operator()<A, TipoExpoente::ZERO>();
+        case TipoExpoente::UM: return f.template operator()<A, TipoExpoente::UM>();
+        case TipoExpoente::DOIS: return f.template operator()<A, TipoExpoente::DOIS>();
+        case TipoExpoente::TRES: return f.template operator()<A, TipoExpoente::TRES>();
+        case TipoExpoente::QUATRO: return f.template operator()<A, TipoExpoente::QUATRO>();
+        default: return f.template operator()<A, TipoExpoente::GENERICO>();
     }
-    matriz_exploracao[pos_ninho.x][pos_ninho.y] = true;
-    pilha_solucao.push_back(pos_ninho);
 }
 
-void Formiga::mover() {
+template<class F>
+static auto despachar_expoentes(const TipoExpoente tipo_alfa, const TipoExpoente tipo_beta, F&& f) {
+    switch (tipo_alfa) {
+        case TipoExpoente::ZERO: return despachar_beta<TipoExpoente::ZERO>(tipo_beta, f);
+        case TipoExpoente::UM: return despachar_beta<TipoExpoente::UM>(tipo_beta, f);
+        case TipoExpoente::DOIS: return despachar_beta<TipoExpoente::DOIS>(tipo_beta, f);
+        case TipoExpoente::TRES: return despachar_beta<TipoExpoente::TRES>(tipo_beta, f);
+        case TipoExpoente::QUATRO: return despachar_beta<TipoExpoente::QUATRO>(tipo_beta, f);
+        default: return despachar_beta<TipoExpoente::GENERICO>(tipo_beta, f);
+    }
+}
+
+template<class Regra>
+long long Formiga::andar(const long long max_passos) {
+    return despachar_expoentes(tipo_alfa, tipo_beta, [&]<TipoExpoente A, TipoExpoente B>() {
+        return this->andar_especializado<Regra, A, B>(max_passos);
+    });
+}
+
+template<class Regra, TipoExpoente A, TipoExpoente B>
+long long Formiga::andar_especializado(const long long max_passos) {
+    // a tabela de heurística pode ter sido preparada para outro beta (outra formiga usando o mesmo labirinto),
+    // nesse caso calcula na hora
+    LeituraPasso leitura;
+    leitura.usar_tabela = lab.heuristica_pronta(beta);
+    if constexpr (A == TipoExpoente::GENERICO) leitura.usar_cache = lab.cache_feromonio_alfa_pronto(alfa);
+
+    long long passos = 0;
+    while (!m_encontrou_comida && !m_fracassou) {
+        this->mover<Regra, A, B>(leitura);
+        passos++;
+        if (passos > max_passos) this->falhar();
+    }
+    return passos;
+}
+
+template<class Regra, TipoExpoente A, TipoExpoente B>
+void Formiga::mover(const LeituraPasso& leitura) {
     if (m_encontrou_comida || m_fracassou) {
         return; // sai do método
     }
 
-    const std::vector<Pos> caminhos = this->get_caminhos_validos();
+    // buffers na pilha de execução, no máximo 4 vizinhos, então mover() não aloca nada no heap
+    std::array<Pos, MAX_VIZINHOS> caminhos;
+    const int n_caminhos = this->get_caminhos_validos(caminhos);
 
-    if (caminhos.empty()) {
+    if (n_caminhos == 0) {
         if (pilha_solucao.size() < 2) {
             this->m_fracassou = true;
             return;
         }
 
+#if ACO_METRICAS
+        this->n_retrocessos++;
+#endif
         this->pilha_solucao.pop_back(); // remove o ultimo elemento (pos atual)
         this->pos_atual = pilha_solucao.back(); // move a formiga pra pos anterior
         // isso mostra que entrou num lugar sem saída
     }
     else {
-        const std::vector<double> chances = Formiga::calcular_chance(caminhos);
+        std::array<double, MAX_VIZINHOS> valores_atratividade;
+        const double soma = Formiga::calcular_chance<A, B>(caminhos, n_caminhos, valores_atratividade, leitura);
 
-        this->pos_atual = Formiga::escolher_proximo(caminhos, chances);
+        this->pos_atual = Formiga::escolher_proximo<Regra>(caminhos, n_caminhos, valores_atratividade, soma);
         this->pilha_solucao.push_back(this->pos_atual);
 
-        matriz_exploracao[pos_atual.x][pos_atual.y] = true;
+        visitados.marcar(lab.indice(pos_atual));
 
         if (this->pos_atual == this->pos_comida) {
             this->m_encontrou_comida = true;
         }
+        else if (limite_poda) {
+            // o caminho ainda precisa de pelo menos a distância Manhattan até a comida. Não é um limite exato
+            // (um retrocesso pode encurtar a pilha depois), mas a formiga que chega aqui já está bem longe do melhor
+            const int restante = std::abs(pos_atual.x - pos_comida.x) + std::abs(pos_atual.y - pos_comida.y);
+            if (static_cast<int>(pilha_solucao.size()) + restante > limite_poda->load(std::memory_order_relaxed)) {
+                this->m_podada = true;
+                this->m_fracassou = true;
+            }
+        }
     }
 }
 
@@ -66,6 +144,14 @@ void Formiga::falhar() {
     this->m_fracassou = true;
 }
 
+void Formiga::set_limite_poda(const std::atomic<int>* limite) {
+    this->limite_poda = limite;
+}
+
+void Formiga::set_q0(const double q0) {
+    this->q0 = q0;
+}
+
 bool Formiga::encontrou_comida() const {
     return m_encontrou_comida;
 }
@@ -74,20 +160,27 @@ bool Formiga::falhou() const {
     return m_fracassou;
 }
 
-const std::vector<Pos>& Formiga::get_pilha_solucao() const {
+bool Formiga::podada() const {
+    return m_podada;
+}
+
+long long Formiga::get_retrocessos() const {
+    return n_retrocessos;
+}
+
+const CaminhoCompacto& Formiga::get_pilha_solucao() const {
     return pilha_solucao;
 }
 
-std::vector<Pos> Formiga::get_caminhos_validos() const {
-    std::vector<Pos> caminhos;
-    caminhos.reserve(4);
-    const std::vector<Pos> movimentos = {
+int Formiga::get_caminhos_validos(std::array<Pos, MAX_VIZINHOS>& caminhos) const {
+    const Pos movimentos[MAX_VIZINHOS] = {
         {this-> pos_atual.x - 1, this-> pos_atual.y},
         {this-> pos_atual.x + 1, this-> pos_atual.y},
         {this-> pos_atual.x, this-> pos_atual.y - 1},
         {this-> pos_atual.x, this-> pos_atual.y + 1}
     };
 
+    int n_caminhos = 0;
     for (const Pos& p : movimentos) {
 
         // verifica se está dentro do grid
@@ -96,11 +189,11 @@ std::vector<Pos> Formiga::get_caminhos_validos() const {
             continue;
         }
 
-        if (lab.get_valor_grid(p) != 1 && !matriz_exploracao[p.x][p.y]) {
-            caminhos.push_back(p);
+        if (!lab.parede_rapida(p) && !visitados.contem(lab.indice(p))) {
+            caminhos[n_caminhos++] = p;
         }
     }
-    return caminhos;
+    return n_caminhos;
 }
 
 double Formiga::get_distancia_heuristica(const Pos& p) const {
@@ -110,38 +203,72 @@ double Formiga::get_distancia_heuristica(const Pos& p) const {
     return 1.0 / (static_cast<double>(dist) + 1e-5); // +1e-5 é para evitar que o valor seja 0
 }
 
-std::vector<double> Formiga::calcular_chance(const std::vector<Pos>& caminhos) const {
-    std::vector<double> valores_atratividade;
-    valores_atratividade.reserve(caminhos.size()); // parte de otimização (alocando a memória só 1x)
+template<TipoExpoente A, TipoExpoente B>
+double Formiga::calcular_chance(const std::array<Pos, MAX_VIZINHOS>& caminhos, const int n_caminhos,
+                                std::array<double, MAX_VIZINHOS>& valores_atratividade,
+                                const LeituraPasso& leitura) const {
+    double soma_valores = 0.0;
+    for (int i=0; i<n_caminhos; i++) {
+        const Pos& p = caminhos[i];
 
-    for (const Pos& p : caminhos) {
-        double feromonio = lab.get_feromonio(p);
-        const double heuristica = get_distancia_heuristica(p);
+        double termo_feromonio;
+        if (leitura.usar_cache) termo_feromonio = lab.feromonio_alfa_rapido(p);
+        else {
+            double feromonio = lab.feromonio_rapido(p);
+            if (feromonio < 1e-10) feromonio = 1e-10; // evita que feromonio seja 0
+            termo_feromonio = elevar<A>(feromonio, alfa);
+        }
 
-        if (feromonio < 1e-10) feromonio = 1e-10; // evita que feromonio seja 0
+        const double termo_heuristica = leitura.usar_tabela ? lab.heuristica_beta_rapida(p)
+                                                            : elevar<B>(get_distancia_heuristica(p), beta);
 
-        valores_atratividade.push_back(std::pow(feromonio, alfa)
-            * std::pow(heuristica, beta));
+        valores_atratividade[i] = termo_feromonio * termo_heuristica;
+        soma_valores += valores_atratividade[i];
     }
-    const double soma_valores = std::accumulate(valores_atratividade.begin(),
-        valores_atratividade.end(), 0.0); // soma todos os valores do primeiro até o último de
-    // valores_atratividade, 0,0 diz que ele começa com esse valor
+    // não precisa normalizar (dividir pela soma), a roleta do escolher_proximo já sorteia em [0, soma)
+    return soma_valores;
+}
+
+TipoExpoente classificar_expoente(const double expoente) {
+    if (expoente == 0.0) return TipoExpoente::ZERO;
+    if (expoente == 1.0) return TipoExpoente::UM;
+    if (expoente == 2.0) return TipoExpoente::DOIS;
+    if (expoente == 3.0) return TipoExpoente::TRES;
+    if (expoente == 4.0) return TipoExpoente::QUATRO;
+    return TipoExpoente::GENERICO;
+}
 
-    if (soma_valores == 0.0) {
-        return std::vector<double>(caminhos.size(), 1.0 / caminhos.size());
+template<class Regra>
+Pos Formiga::escolher_proximo(const std::array<Pos, MAX_VIZINHOS>& caminhos, const int n_caminhos,
+                              const std::array<double, MAX_VIZINHOS>& valores_atratividade, const double soma) {
+    double u = gen.uniforme();
+
+    if constexpr (std::is_same_v<Regra, RegraPseudoAleatoria>) {
+        if (u < q0) { // explotação: o mais atrativo, empate fica com o primeiro
+            int melhor = 0;
+            for (int i=1; i<n_caminhos; i++) {
+                if (valores_atratividade[i] > valores_atratividade[melhor]) melhor = i;
+            }
+            return caminhos[melhor];
+        }
+        // o mesmo sorteio, esticado de [q0, 1) para [0, 1), vira a roleta. Continua 1 número aleatório por passo
+        u = (u - q0) / (1.0 - q0);
     }
 
-    // sintaxe esquisita, mas esse comando vai somar os valores e dividir cada um dos valores pela soma deles
-    // fazendo com que a soma de tudo vire 1,0, ajustando para a porcentagem
-    std::ranges::transform(valores_atratividade,
-                           valores_atratividade.begin(),
-                           [soma_valores](const double v) { return v / soma_valores; });
+    if (!(soma > 0.0)) { // todas as atratividades deram 0 (ou soma inválida), sorteia igual entre os caminhos
+        return caminhos[std::min(static_cast<int>(u * n_caminhos), n_caminhos - 1)];
+    }
 
-    return valores_atratividade;
+    // roleta: anda somando as fatias até passar do ponto sorteado, só 1 número aleatório por passo
+    const double alvo = u * soma;
+    double acumulado = 0.0;
+    for (int i=0; i<n_caminhos-1; i++) {
+        acumulado += valores_atratividade[i];
+        if (alvo < acumulado) return caminhos[i];
+    }
+    return caminhos[n_caminhos-1]; // o último fica com o resto, evita erro de arredondamento
 }
 
-Pos Formiga::escolher_proximo(const std::vector<Pos> &caminhos, const std::vector<double> &chances) {
-    std::discrete_distribution<> dist(chances.begin(), chances.end());
-    int const indice_escolhido = dist(gen);
-    return caminhos[indice_escolhido];
-}
\ No newline at end of file
+// as duas regras que existem, para o andar<Regra> (e os passos especializados) poder ficar aqui no .cpp
+template long long Formiga::andar<RegraProporcional>(long long max_passos);
+template long long Formiga::andar<RegraPseudoAleatoria>(long long max_passos);
@@ -1,27 +1,97 @@
 #ifndef ACO_LABIRINTO_FORMIGA_H
 #define ACO_LABIRINTO_FORMIGA_H
 
+#include "Aleatorio.h"
+#include "CaminhoCompacto.h"
+#include "ConjuntoVisitados.h"
 #include "Labirinto.h"
+#include "Metricas.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <vector>
-#include <random>
+
+constexpr int MAX_VIZINHOS = 4; // cima, baixo, esquerda, direita
+
+// Expoentes comuns (ALFA = 1, BETA inteiro) ganham uma versão do passo gerada em tempo de compilação, sem std::pow.
+// GENERICO cai no std::pow (ou no cache de feromonio^alfa do Labirinto, se estiver ativo)
+enum class TipoExpoente : std::uint8_t { ZERO, UM, DOIS, TRES, QUATRO, GENERICO };
+[[nodiscard]] TipoExpoente classificar_expoente(double expoente);
+
+template<TipoExpoente T>
+double elevar(const double base, const double expoente) {
+    if constexpr (T == TipoExpoente::ZERO) return 1.0;
+    else if constexpr (T == TipoExpoente::UM) return base;
+    else if constexpr (T == TipoExpoente::DOIS) return base * base;
+    else if constexpr (T == TipoExpoente::TRES) return base * base * base;
+    else if constexpr (T == TipoExpoente::QUATRO) {
+        const double quadrado = base * base;
+        return quadrado * quadrado;
+    }
+    else return std::pow(base, expoente);
+}
+
+// Regras de escolha do próximo passo, decididas em tempo de compilação (andar<Regra>)
+struct RegraProporcional {}; // roleta proporcional à atratividade (AS, elitista, MMAS, rank)
+struct RegraPseudoAleatoria {}; // ACS: com chance q0 vai direto no caminho mais atrativo, senão faz a roleta
 
 class Formiga {
 public:
-    Formiga(Labirinto& labirinto, double alfa, double beta);
-    void mover();
+    Formiga(Labirinto& labirinto, double alfa, double beta, ModoVisitados modo_visitados = ModoVisitados::AUTOMATICO);
+    // Anda até achar a comida ou falhar. Passando de max_passos ela falha (timeout), então retorna no máximo
+    // max_passos + 1 passos. O tipo do alfa e do beta é escolhido aqui, uma vez por formiga, e o passo
+    // (mover<Regra, A, B>) fica com o cálculo de chance inline, sem nenhuma chamada indireta
+    template<class Regra = RegraProporcional>
+    long long andar(long long max_passos);
     void reset();
+    // Pega o ninho/comida atuais do Labirinto (depois de um set_ninho_comida) e volta para o ninho novo
+    void atualizar_ninho_comida();
+    // Troca o gerador pelo fluxo (semente_mestre, id_formiga, iteracao). Chamado pela colônia antes de cada
+    // iteração para o resultado não depender de quantas threads estão rodando
+    void semear(std::uint64_t semente_mestre, int id_formiga, int iteracao);
     void falhar();
+    // Poda: se o caminho atual + a distância Manhattan até a comida passar do limite, a formiga desiste (conta
+    // como falhou() e podada()). nullptr desliga. O limite é de quem chama (a Colonia) e pode mudar durante a
+    // iteração, por isso é atômico
+    void set_limite_poda(const std::atomic<int>* limite);
+    void set_q0(double q0); // só usado pela RegraPseudoAleatoria
 
     [[nodiscard]] bool encontrou_comida() const;
     [[nodiscard]] bool falhou() const;
-    [[nodiscard]] const std::vector<Pos>& get_pilha_solucao() const;
+    [[nodiscard]] bool podada() const;
+    [[nodiscard]] long long get_retrocessos() const; // só conta com ACO_METRICAS ligado
+    [[nodiscard]] const CaminhoCompacto& get_pilha_solucao() const;
 
 private:
-    [[nodiscard]] std::vector<Pos> get_caminhos_validos() const;
+    // o motor em lote anda a formiga por fora (com o estado dele) e escreve o caminho e o resultado direto aqui
+    friend class LoteFormigas;
+
+    // Preenche caminhos com os vizinhos livres e não visitados, retorna quantos são
+    int get_caminhos_validos(std::array<Pos, MAX_VIZINHOS>& caminhos) const;
     [[nodiscard]] double get_distancia_heuristica(const Pos& p) const;
-    [[nodiscard]] std::vector<double> calcular_chance(const std::vector<Pos>& caminhos) const;
+    // De onde o passo tira os termos da atratividade. O labirinto não muda durante a construção, então é decidido
+    // uma vez no andar e não a cada passo
+    struct LeituraPasso {
+        bool usar_tabela = false; // heurística da tabela do Labirinto (preparada para este beta)
+        bool usar_cache = false; // feromonio^alfa do cache do Labirinto (só com alfa GENERICO)
+    };
+
+    // Preenche a atratividade de cada caminho (sem normalizar) e retorna a soma delas. A e B são os tipos do alfa
+    // e do beta (classificar_expoente)
+    template<TipoExpoente A, TipoExpoente B>
+    double calcular_chance(const std::array<Pos, MAX_VIZINHOS>& caminhos, int n_caminhos,
+                           std::array<double, MAX_VIZINHOS>& valores_atratividade, const LeituraPasso& leitura) const;
 
-    Pos escolher_proximo(const std::vector<Pos>& caminhos, const std::vector<double>& chances);
+    // Um passo (ou um retrocesso)
+    template<class Regra, TipoExpoente A, TipoExpoente B>
+    void mover(const LeituraPasso& leitura);
+    template<class Regra, TipoExpoente A, TipoExpoente B>
+    long long andar_especializado(long long max_passos);
+
+    template<class Regra>
+    Pos escolher_proximo(const std::array<Pos, MAX_VIZINHOS>& caminhos, int n_caminhos,
+                         const std::array<double, MAX_VIZINHOS>& valores_atratividade, double soma);
 
     Labirinto& lab;
 
@@ -29,6 +99,9 @@ private:
     int tamanho_volta;
     double alfa;
     double beta;
+    double q0 = 0.0;
+    TipoExpoente tipo_alfa;
+    TipoExpoente tipo_beta;
 
     Pos pos_ninho;
     Pos pos_comida;
@@ -37,12 +110,18 @@ private:
     Pos pos_atual;
     bool m_encontrou_comida;
     bool m_fracassou;
+    bool m_podada;
+
+    const std::atomic<int>* limite_poda = nullptr;
+    long long n_retrocessos = 0;
 
-    std::vector<Pos> pilha_solucao; // Usado para backtracking
-    std::vector<std::vector<bool>> matriz_exploracao;
+    // Usado para backtracking. Em 2 bits por passo: a capacidade fica de uma iteração para a outra, então depois
+    // das primeiras iterações a formiga não aloca mais nada
+    CaminhoCompacto pilha_solucao;
+    ConjuntoVisitados visitados; // células por onde a formiga já passou nesta iteração
 
     // Gerador de números aleatórios
-    std::mt19937 gen;
+    GeradorAleatorio gen;
 };
 
 
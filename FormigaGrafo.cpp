@@ -0,0 +1,149 @@
+#include "FormigaGrafo.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+FormigaGrafo::FormigaGrafo(const GrafoJuncoes &grafo, const std::vector<double> &feromonio_aresta,
+                           const std::vector<double> &heuristica_no, const double alfa)
+    :   grafo(grafo),
+        feromonio_aresta(feromonio_aresta),
+        heuristica_no(heuristica_no),
+        alfa(alfa),
+        visitados(grafo.get_n_nos(), ModoVisitados::AUTOMATICO)
+{
+    FormigaGrafo::reset();
+}
+
+void FormigaGrafo::reset() {
+    m_encontrou_comida = false;
+    m_fracassou = false;
+    m_podada = false;
+    no_atual = grafo.get_no_ninho();
+    tamanho_caminho = 1;
+    n_retrocessos = 0;
+
+    pilha_nos.clear();
+    pilha_arestas.clear();
+    visitados.limpar();
+    visitados.marcar(no_atual);
+    pilha_nos.push_back(no_atual);
+}
+
+void FormigaGrafo::semear(const std::uint64_t semente_mestre, const int id_formiga, const int iteracao) {
+    this->gen = GeradorAleatorio::para_fluxo(semente_mestre, id_formiga, iteracao);
+}
+
+void FormigaGrafo::mover() {
+    if (m_encontrou_comida || m_fracassou) {
+        return;
+    }
+
+    // um nó do grid tem no máximo 4 corredores saindo dele
+    std::array<VizinhoGrafo, 4> caminhos;
+    std::array<double, 4> valores_atratividade;
+    int n_caminhos = 0;
+    double soma = 0.0;
+
+    for (const VizinhoGrafo* v = grafo.vizinhos_begin(no_atual); v != grafo.vizinhos_end(no_atual); ++v) {
+        if (visitados.contem(v->no)) continue;
+
+        double feromonio = feromonio_aresta[v->aresta];
+        if (feromonio < 1e-10) feromonio = 1e-10;
+        const double termo_feromonio = alfa == 1.0 ? feromonio : std::pow(feromonio, alfa);
+
+        caminhos[n_caminhos] = *v;
+        valores_atratividade[n_caminhos] = termo_feromonio * heuristica_no[v->no];
+        soma += valores_atratividade[n_caminhos];
+        n_caminhos++;
+    }
+
+    if (n_caminhos == 0) {
+        if (pilha_nos.size() < 2) {
+            this->m_fracassou = true;
+            return;
+        }
+#if ACO_METRICAS
+        n_retrocessos++;
+#endif
+        // volta o corredor inteiro de uma vez
+        tamanho_caminho -= grafo.get_aresta(pilha_arestas.back()).comprimento;
+        pilha_arestas.pop_back();
+        pilha_nos.pop_back();
+        no_atual = pilha_nos.back();
+        return;
+    }
+
+    // roleta com um sorteio só, igual à Formiga
+    const double u = gen.uniforme();
+    int escolhido = n_caminhos - 1;
+    if (!(soma > 0.0)) {
+        escolhido = std::min(static_cast<int>(u * n_caminhos), n_caminhos - 1);
+    }
+    else {
+        const double alvo = u * soma;
+        double acumulado = 0.0;
+        for (int i=0; i<n_caminhos-1; i++) {
+            acumulado += valores_atratividade[i];
+            if (alvo < acumulado) {
+                escolhido = i;
+                break;
+            }
+        }
+    }
+
+    const VizinhoGrafo& proximo = caminhos[escolhido];
+    no_atual = proximo.no;
+    tamanho_caminho += grafo.get_aresta(proximo.aresta).comprimento;
+    pilha_nos.push_back(no_atual);
+    pilha_arestas.push_back(proximo.aresta);
+    visitados.marcar(no_atual);
+
+    if (no_atual == grafo.get_no_comida()) {
+        m_encontrou_comida = true;
+    }
+    else if (limite_poda) {
+        const Pos p = grafo.get_pos_no(no_atual);
+        const Pos comida = grafo.get_pos_no(grafo.get_no_comida());
+        const int restante = std::abs(p.x - comida.x) + std::abs(p.y - comida.y);
+        if (tamanho_caminho + restante > limite_poda->load(std::memory_order_relaxed)) {
+            m_podada = true;
+            m_fracassou = true;
+        }
+    }
+}
+
+void FormigaGrafo::falhar() {
+    this->m_fracassou = true;
+}
+
+void FormigaGrafo::set_limite_poda(const std::atomic<int>* limite) {
+    this->limite_poda = limite;
+}
+
+bool FormigaGrafo::encontrou_comida() const {
+    return m_encontrou_comida;
+}
+
+bool FormigaGrafo::falhou() const {
+    return m_fracassou;
+}
+
+bool FormigaGrafo::podada() const {
+    return m_podada;
+}
+
+long long FormigaGrafo::get_retrocessos() const {
+    return n_retrocessos;
+}
+
+const std::vector<int>& FormigaGrafo::get_pilha_nos() const {
+    return pilha_nos;
+}
+
+const std::vector<int>& FormigaGrafo::get_pilha_arestas() const {
+    return pilha_arestas;
+}
+
+int FormigaGrafo::get_tamanho_caminho() const {
+    return tamanho_caminho;
+}
@@ -0,0 +1,57 @@
+#ifndef ACO_LABIRINTO_FORMIGAGRAFO_H
+#define ACO_LABIRINTO_FORMIGAGRAFO_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Aleatorio.h"
+#include "ConjuntoVisitados.h"
+#include "GrafoJuncoes.h"
+#include "Metricas.h"
+
+// Mesma ideia da Formiga, mas andando no GrafoJuncoes: cada passo atravessa um corredor inteiro, e só existe
+// decisão (e cálculo de chance) nas junções. O feromônio fica nas arestas
+class FormigaGrafo {
+public:
+    FormigaGrafo(const GrafoJuncoes& grafo, const std::vector<double>& feromonio_aresta,
+                 const std::vector<double>& heuristica_no, double alfa);
+    void mover();
+    void reset();
+    void falhar();
+    void semear(std::uint64_t semente_mestre, int id_formiga, int iteracao);
+    void set_limite_poda(const std::atomic<int>* limite); // igual ao da Formiga, em células
+
+    [[nodiscard]] bool encontrou_comida() const;
+    [[nodiscard]] bool falhou() const;
+    [[nodiscard]] bool podada() const;
+    [[nodiscard]] long long get_retrocessos() const; // só conta com ACO_METRICAS ligado
+    [[nodiscard]] const std::vector<int>& get_pilha_nos() const;
+    [[nodiscard]] const std::vector<int>& get_pilha_arestas() const;
+    // Tamanho do caminho em células (igual ao get_pilha_solucao().size() da Formiga normal)
+    [[nodiscard]] int get_tamanho_caminho() const;
+
+private:
+    const GrafoJuncoes& grafo;
+    const std::vector<double>& feromonio_aresta;
+    const std::vector<double>& heuristica_no; // heuristica^beta de cada nó
+    double alfa;
+
+    int no_atual;
+    int tamanho_caminho;
+    bool m_encontrou_comida;
+    bool m_fracassou;
+    bool m_podada;
+
+    const std::atomic<int>* limite_poda = nullptr;
+    long long n_retrocessos = 0;
+
+    std::vector<int> pilha_nos; // Usado para backtracking
+    std::vector<int> pilha_arestas; // aresta usada para chegar em pilha_nos[i+1]
+    ConjuntoVisitados visitados;
+
+    GeradorAleatorio gen;
+};
+
+
+#endif //ACO_LABIRINTO_FORMIGAGRAFO_H
@@ -0,0 +1,284 @@
+#include "GeradorLabirinto.h"
+#include <algorithm>
+
+#include "Aleatorio.h"
+
+namespace {
+
+// número sorteado em [0, n) sem o "% n" (multiplica 32 bits aleatórios por n e pega a parte alta)
+std::uint32_t sortear(GeradorAleatorio& gen, const std::uint32_t n) {
+    return static_cast<std::uint32_t>(((gen() >> 32) * n) >> 32);
+}
+
+void gerar_pilares(const int largura, const int altura, std::vector<std::uint8_t>& grid,
+                   GeradorAleatorio* gen, const int chance_parede_adicional) {
+    for (int i=0; i<largura; i++) {
+        for (int j=0; j<altura; j++) {
+            std::uint8_t& celula = grid[static_cast<size_t>(i)*altura + j];
+            if ((i%2 == 0 && j%2 == 0) || i == 0 || i == largura-1 || j == altura-1 || j == 0) {
+                celula = 1; // pilares e bordas
+            }
+            else if (gen != nullptr && ((i%2 == 0 && j%2 == 1) || (i%2 == 1 && j%2 == 0))) {
+                if (static_cast<int>(sortear(*gen, 100)) < chance_parede_adicional) {
+                    celula = 1; // paredes aleatórias do lado dos pilares
+                }
+            }
+        }
+    }
+}
+
+// Labirintos perfeitos trabalham numa "grade de salas": a sala (cx, cy) fica na célula (2cx+1, 2cy+1) e a parede
+// entre duas salas vizinhas fica na célula do meio
+struct GradeSalas {
+    int largura, altura; // do labirinto
+    int n_x, n_y; // número de salas em cada direção
+
+    GradeSalas(const int largura, const int altura)
+        : largura(largura), altura(altura), n_x((largura-1)/2), n_y((altura-1)/2) {}
+
+    [[nodiscard]] size_t celula(const int cx, const int cy) const {
+        return static_cast<size_t>(2*cx + 1) * altura + (2*cy + 1);
+    }
+    [[nodiscard]] size_t parede_entre(const int cx, const int cy, const int dx, const int dy) const {
+        return static_cast<size_t>(2*cx + 1 + dx) * altura + (2*cy + 1 + dy);
+    }
+};
+
+constexpr int DX[4] = {-1, 1, 0, 0};
+constexpr int DY[4] = {0, 0, -1, 1};
+
+void gerar_backtracker(const GradeSalas& salas, std::vector<std::uint8_t>& grid, GeradorAleatorio& gen) {
+    // salas ainda não visitadas ficam marcadas com SALA_NOVA, o resto é parede. Assim a vizinha de uma sala é só
+    // índice ±2 e ±2*altura: se ela cair fora da grade de salas, cai numa borda (valor 1) ou fora do vetor
+    constexpr std::uint8_t SALA_NOVA = 4;
+    std::ranges::fill(grid, 1);
+    for (int cx=0; cx<salas.n_x; cx++) {
+        for (int cy=0; cy<salas.n_y; cy++) grid[salas.celula(cx, cy)] = SALA_NOVA;
+    }
+    const std::int64_t passos[4] = {-static_cast<std::int64_t>(salas.altura), salas.altura, -1, 1};
+    const auto tamanho = static_cast<std::int64_t>(grid.size());
+
+    // DFS iterativa (uma recursiva estouraria a pilha em labirintos grandes)
+    std::vector<std::int64_t> pilha;
+    pilha.reserve(1024);
+    pilha.push_back(static_cast<std::int64_t>(salas.celula(0, 0)));
+    grid[pilha.back()] = 0;
+
+    while (!pilha.empty()) {
+        const std::int64_t sala = pilha.back();
+
+        int opcoes[4], n_opcoes = 0;
+        for (int d=0; d<4; d++) {
+            const std::int64_t vizinha = sala + 2*passos[d];
+            if (vizinha >= 0 && vizinha < tamanho && grid[vizinha] == SALA_NOVA) opcoes[n_opcoes++] = d;
+        }
+
+        if (n_opcoes == 0) {
+            pilha.pop_back();
+            continue;
+        }
+
+        const int d = opcoes[sortear(gen, n_opcoes)];
+        grid[sala + passos[d]] = 0; // parede do meio
+        grid[sala + 2*passos[d]] = 0;
+        pilha.push_back(sala + 2*passos[d]);
+    }
+}
+
+// union-find com compressão de caminho (halving) e união por tamanho. Num vetor só: raiz guarda -tamanho,
+// o resto guarda o pai (metade dos acessos aleatórios de ter pai e tamanho separados)
+struct ConjuntosDisjuntos {
+    std::vector<std::int32_t> pai;
+
+    explicit ConjuntosDisjuntos(const int n) : pai(n, -1) {}
+
+    int achar(int x) {
+        while (pai[x] >= 0) {
+            const int avo = pai[pai[x]];
+            if (avo >= 0) pai[x] = avo;
+            x = pai[x];
+        }
+        return x;
+    }
+
+    bool unir(int a, int b) {
+        a = achar(a);
+        b = achar(b);
+        if (a == b) return false;
+        if (pai[a] > pai[b]) std::swap(a, b); // a fica sendo o maior (tamanho mais negativo)
+        pai[a] += pai[b];
+        pai[b] = a;
+        return true;
+    }
+};
+
+void gerar_kruskal(const GradeSalas& salas, std::vector<std::uint8_t>& grid, GeradorAleatorio& gen) {
+    std::ranges::fill(grid, 1);
+    for (int cx=0; cx<salas.n_x; cx++) {
+        for (int cy=0; cy<salas.n_y; cy++) grid[salas.celula(cx, cy)] = 0;
+    }
+
+    // cada parede interna vira um número: sala*2 + (0 = parede da direita em x, 1 = parede de baixo em y)
+    std::vector<std::uint32_t> paredes;
+    paredes.reserve(static_cast<size_t>(salas.n_x) * salas.n_y * 2);
+    for (int cx=0; cx<salas.n_x; cx++) {
+        for (int cy=0; cy<salas.n_y; cy++) {
+            const std::uint32_t sala = cx * salas.n_y + cy;
+            if (cx + 1 < salas.n_x) paredes.push_back(sala * 2);
+            if (cy + 1 < salas.n_y) paredes.push_back(sala * 2 + 1);
+        }
+    }
+    // Fisher-Yates
+    for (size_t i=paredes.size(); i>1; i--) {
+        std::swap(paredes[i-1], paredes[sortear(gen, static_cast<std::uint32_t>(i))]);
+    }
+
+    ConjuntosDisjuntos conjuntos(salas.n_x * salas.n_y);
+    for (const std::uint32_t parede : paredes) {
+        const int sala = static_cast<int>(parede / 2);
+        const int cx = sala / salas.n_y, cy = sala % salas.n_y;
+        const int dx = parede % 2 == 0 ? 1 : 0, dy = 1 - dx;
+        const int vizinha = (cx + dx) * salas.n_y + (cy + dy);
+        if (conjuntos.unir(sala, vizinha)) {
+            grid[salas.parede_entre(cx, cy, dx, dy)] = 0;
+        }
+    }
+}
+
+// Abre uma parede de cada beco sem saída com probabilidade densidade_lacos, de preferência na direção de outro beco
+void trancar(const GradeSalas& salas, std::vector<std::uint8_t>& grid, GeradorAleatorio& gen,
+             const double densidade_lacos) {
+    for (int cx=0; cx<salas.n_x; cx++) {
+        for (int cy=0; cy<salas.n_y; cy++) {
+            int fechadas[4], n_fechadas = 0, n_abertas = 0;
+            for (int d=0; d<4; d++) {
+                const int nx = cx + DX[d], ny = cy + DY[d];
+                if (nx < 0 || nx >= salas.n_x || ny < 0 || ny >= salas.n_y) continue;
+                if (grid[salas.parede_entre(cx, cy, DX[d], DY[d])] == 0) n_abertas++;
+                else fechadas[n_fechadas++] = d;
+            }
+            if (n_abertas != 1 || n_fechadas == 0) continue; // não é beco sem saída
+            if (gen.uniforme() >= densidade_lacos) continue;
+
+            // prefere derrubar a parede que dá em outro beco, assim um laço resolve dois becos
+            int escolhida = fechadas[sortear(gen, n_fechadas)];
+            for (int k=0; k<n_fechadas; k++) {
+                const int d = fechadas[k];
+                const int nx = cx + DX[d], ny = cy + DY[d];
+                int abertas_vizinha = 0;
+                for (int e=0; e<4; e++) {
+                    const int vx = nx + DX[e], vy = ny + DY[e];
+                    if (vx < 0 || vx >= salas.n_x || vy < 0 || vy >= salas.n_y) continue;
+                    if (grid[salas.parede_entre(nx, ny, DX[e], DY[e])] == 0) abertas_vizinha++;
+                }
+                if (abertas_vizinha == 1) {
+                    escolhida = d;
+                    break;
+                }
+            }
+            grid[salas.parede_entre(cx, cy, DX[escolhida], DY[escolhida])] = 0;
+        }
+    }
+}
+
+} // namespace
+
+void gerar_labirinto(const ConfigLabirinto &config, const int largura, const int altura,
+                     std::vector<std::uint8_t> &grid, Pos &pos_ninho, Pos &pos_comida) {
+    grid.assign(static_cast<size_t>(largura) * altura, 0);
+    GeradorAleatorio gen(config.semente);
+    // os pilares podem cair em cima do ninho ou da comida, que têm que ser chão
+    const auto abrir_ninho_comida = [&] {
+        grid[static_cast<size_t>(pos_ninho.x) * altura + pos_ninho.y] = 0;
+        grid[static_cast<size_t>(pos_comida.x) * altura + pos_comida.y] = 0;
+    };
+
+    switch (config.algoritmo) {
+        case AlgoritmoLabirinto::PILARES:
+            gerar_pilares(largura, altura, grid, nullptr, 0);
+            pos_comida = {1, altura-2};
+            pos_ninho = {largura-2, 1};
+            abrir_ninho_comida();
+            return;
+
+        case AlgoritmoLabirinto::PILARES_DIFICIL:
+            pos_ninho = {1, altura-2};
+            pos_comida = {largura-2, 1};
+            // sorteia de novo (continuando o mesmo gerador) até achar um que tenha solução
+            do {
+                std::ranges::fill(grid, 0);
+                gerar_pilares(largura, altura, grid, &gen, config.chance_parede_adicional);
+                abrir_ninho_comida();
+            } while (!labirinto_tem_solucao(grid, largura, altura, pos_ninho, pos_comida));
+            return;
+
+        default:
+            break;
+    }
+
+    const GradeSalas salas(largura, altura);
+    if (config.algoritmo == AlgoritmoLabirinto::KRUSKAL) gerar_kruskal(salas, grid, gen);
+    else gerar_backtracker(salas, grid, gen);
+
+    if (config.algoritmo == AlgoritmoLabirinto::TRANCADO) trancar(salas, grid, gen, config.densidade_lacos);
+
+    // cantos opostos, nas últimas salas (coordenada ímpar). Labirinto perfeito sempre tem solução
+    pos_ninho = {1, 2*salas.n_y - 1};
+    pos_comida = {2*salas.n_x - 1, 1};
+}
+
+bool labirinto_tem_solucao(const std::vector<std::uint8_t> &grid, const int largura, const int altura,
+                           const Pos &pos_ninho, const Pos &pos_comida) {
+    const auto indice = [altura](const Pos& p) { return static_cast<std::uint32_t>(p.x) * altura + p.y; };
+    const std::uint32_t alvo = indice(pos_comida);
+    if (grid[indice(pos_ninho)] == 1 || grid[alvo] == 1) return false;
+
+    // visitado como bitset (1 bit por célula) e BFS por "camadas": só guarda a fronteira atual e a próxima, então a
+    // memória extra é proporcional à fronteira e não ao labirinto
+    std::vector<std::uint64_t> visitado((grid.size() + 63) / 64, 0);
+    const auto marcar = [&visitado](const std::uint32_t i) {
+        const std::uint64_t bit = std::uint64_t{1} << (i % 64);
+        if (visitado[i / 64] & bit) return false;
+        visitado[i / 64] |= bit;
+        return true;
+    };
+
+    // Todos os geradores daqui fecham a borda com parede. Nesse caso nenhuma célula da fila está na borda, e os
+    // vizinhos são só índice ±1 e ±altura, sem divisão nem checagem de limite
+    bool borda_fechada = true;
+    for (int i=0; i<largura && borda_fechada; i++) {
+        borda_fechada = grid[indice({i, 0})] == 1 && grid[indice({i, altura-1})] == 1;
+    }
+    for (int j=0; j<altura && borda_fechada; j++) {
+        borda_fechada = grid[indice({0, j})] == 1 && grid[indice({largura-1, j})] == 1;
+    }
+    const std::int64_t passos[4] = {-static_cast<std::int64_t>(altura), altura, -1, 1};
+
+    std::vector<std::uint32_t> fronteira = {indice(pos_ninho)}, proxima;
+    marcar(fronteira[0]);
+
+    while (!fronteira.empty()) {
+        proxima.clear();
+        for (const std::uint32_t i : fronteira) {
+            if (i == alvo) return true;
+
+            if (borda_fechada) {
+                for (const std::int64_t passo : passos) {
+                    const auto j = static_cast<std::uint32_t>(i + passo);
+                    if (grid[j] != 1 && marcar(j)) proxima.push_back(j);
+                }
+                continue;
+            }
+
+            const int x = static_cast<int>(i / altura), y = static_cast<int>(i % altura);
+            for (int d=0; d<4; d++) {
+                const int nx = x + DX[d], ny = y + DY[d];
+                if (nx < 0 || nx >= largura || ny < 0 || ny >= altura) continue;
+                const std::uint32_t j = static_cast<std::uint32_t>(nx) * altura + ny;
+                if (grid[j] != 1 && marcar(j)) proxima.push_back(j);
+            }
+        }
+        std::swap(fronteira, proxima);
+    }
+    return false;
+}
@@ -0,0 +1,36 @@
+#ifndef ACO_LABIRINTO_GERADORLABIRINTO_H
+#define ACO_LABIRINTO_GERADORLABIRINTO_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Labirinto.h"
+
+// PILARES: só os pilares nas posições pares e as bordas (o criar_grid original).
+// PILARES_DIFICIL: pilares + paredes aleatórias do lado dos pilares (o criar_grid_dificil original), gerado de novo
+// até ter solução.
+// BACKTRACKER: labirinto perfeito (um caminho só entre quaisquer duas células) por busca em profundidade.
+// KRUSKAL: labirinto perfeito derrubando paredes em ordem aleatória com union-find, corredores mais curtos e
+// mais bifurcações que o BACKTRACKER.
+// TRANCADO: BACKTRACKER com parte dos becos sem saída abertos, o que cria laços (caminhos alternativos)
+enum class AlgoritmoLabirinto { PILARES, PILARES_DIFICIL, BACKTRACKER, KRUSKAL, TRANCADO };
+
+struct ConfigLabirinto {
+    AlgoritmoLabirinto algoritmo = AlgoritmoLabirinto::PILARES_DIFICIL;
+    std::uint64_t semente = 1; // mesma semente e mesmo tamanho = mesmo labirinto
+    int chance_parede_adicional = 20; // PILARES_DIFICIL: 5 = 5%, 20 = 20%
+    double densidade_lacos = 0.25; // TRANCADO: fração dos becos sem saída que viram laço (0 = perfeito, 1 = nenhum beco)
+};
+
+// Preenche grid (0 = chão, 1 = parede, x*altura + y) e as posições do ninho e da comida.
+// Os algoritmos de labirinto perfeito usam as células de coordenada ímpar, então com largura/altura pares a última
+// linha/coluna antes da borda fica toda de parede
+void gerar_labirinto(const ConfigLabirinto& config, int largura, int altura,
+                     std::vector<std::uint8_t>& grid, Pos& pos_ninho, Pos& pos_comida);
+
+// Busca em largura do ninho até a comida, O(largura*altura). Ninho ou comida em cima de parede = sem solução
+[[nodiscard]] bool labirinto_tem_solucao(const std::vector<std::uint8_t>& grid, int largura, int altura,
+                                         const Pos& pos_ninho, const Pos& pos_comida);
+
+
+#endif //ACO_LABIRINTO_GERADORLABIRINTO_H
@@ -0,0 +1,134 @@
+#include "GrafoJuncoes.h"
+#include <stdexcept>
+#include <utility>
+
+constexpr int DX[4] = {-1, 1, 0, 0};
+constexpr int DY[4] = {0, 0, -1, 1};
+
+GrafoJuncoes::GrafoJuncoes(const Labirinto &labirinto) {
+    const int largura = labirinto.get_largura();
+    const int altura = labirinto.get_altura();
+    const Pos pos_ninho = labirinto.get_pos_ninho();
+    const Pos pos_comida = labirinto.get_pos_comida();
+
+    auto livre = [&](const Pos& p) {
+        return p.x >= 0 && p.x < largura && p.y >= 0 && p.y < altura && !labirinto.parede_rapida(p);
+    };
+    // o ninho e a comida viram nós, então têm que ser chão
+    if (!livre(pos_ninho) || !livre(pos_comida)) {
+        throw std::runtime_error("Ninho ou comida em cima de uma parede, o grafo de juncoes precisa dos dois livres!");
+    }
+
+    // 1) Nós: toda célula livre que não é "meio de corredor" (exatamente 2 vizinhos livres), mais ninho e comida
+    std::vector<int> no_da_celula(static_cast<size_t>(largura) * altura, -1);
+    for (int i=0; i<largura; i++) {
+        for (int j=0; j<altura; j++) {
+            const Pos p = {i, j};
+            if (!livre(p)) continue;
+
+            int grau = 0;
+            for (int d=0; d<4; d++) grau += livre({i + DX[d], j + DY[d]});
+
+            if (grau != 2 || p == pos_ninho || p == pos_comida) {
+                no_da_celula[labirinto.indice(p)] = static_cast<int>(pos_nos.size());
+                pos_nos.push_back(p);
+            }
+        }
+    }
+    no_ninho = no_da_celula[labirinto.indice(pos_ninho)];
+    no_comida = no_da_celula[labirinto.indice(pos_comida)];
+
+    // 2) Arestas: sai de cada nó em cada direção livre e segue o corredor até bater em outro nó.
+    // Cada corredor é achado duas vezes (uma de cada ponta), então só registra pela ponta de menor "chave"
+    std::vector<Pos> meio;
+    for (int a=0; a<static_cast<int>(pos_nos.size()); a++) {
+        for (int d=0; d<4; d++) {
+            const Pos inicio = {pos_nos[a].x + DX[d], pos_nos[a].y + DY[d]};
+            if (!livre(inicio)) continue;
+
+            meio.clear();
+            Pos anterior = pos_nos[a], atual = inicio;
+            while (no_da_celula[labirinto.indice(atual)] == -1) {
+                meio.push_back(atual);
+                // célula de corredor tem exatamente 2 vizinhos livres, o próximo é o que não é o anterior
+                for (int k=0; k<4; k++) {
+                    const Pos prox = {atual.x + DX[k], atual.y + DY[k]};
+                    if (livre(prox) && !(prox == anterior)) {
+                        anterior = atual;
+                        atual = prox;
+                        break;
+                    }
+                }
+            }
+            const int b = no_da_celula[labirinto.indice(atual)];
+            if (a == b) continue; // laço que volta pro mesmo nó, nenhuma formiga usaria
+
+            const std::pair chave_a = {a, labirinto.indice(inicio)};
+            const std::pair chave_b = {b, labirinto.indice(meio.empty() ? pos_nos[a] : meio.back())};
+            if (chave_b < chave_a) continue;
+
+            arestas.push_back({a, b, static_cast<int>(meio.size()) + 1,
+                               static_cast<int>(celulas_corredores.size()), static_cast<int>(meio.size())});
+            celulas_corredores.insert(celulas_corredores.end(), meio.begin(), meio.end());
+        }
+    }
+
+    // 3) Lista de adjacência compacta (CSR)
+    inicio_vizinhos.assign(pos_nos.size() + 1, 0);
+    for (const ArestaGrafo& aresta : arestas) {
+        inicio_vizinhos[aresta.origem + 1]++;
+        inicio_vizinhos[aresta.destino + 1]++;
+    }
+    for (size_t i=1; i<inicio_vizinhos.size(); i++) inicio_vizinhos[i] += inicio_vizinhos[i-1];
+
+    vizinhos.resize(arestas.size() * 2);
+    std::vector<int> preenchidos(inicio_vizinhos.begin(), inicio_vizinhos.end() - 1);
+    for (int e=0; e<static_cast<int>(arestas.size()); e++) {
+        vizinhos[preenchidos[arestas[e].origem]++] = {e, arestas[e].destino};
+        vizinhos[preenchidos[arestas[e].destino]++] = {e, arestas[e].origem};
+    }
+}
+
+void GrafoJuncoes::expandir_caminho(const std::vector<int> &nos, const std::vector<int> &arestas_usadas,
+                                    std::vector<Pos> &celulas) const {
+    celulas.clear();
+    if (nos.empty()) return;
+
+    celulas.push_back(pos_nos[nos[0]]);
+    for (size_t k=0; k<arestas_usadas.size(); k++) {
+        const ArestaGrafo& a = arestas[arestas_usadas[k]];
+        if (a.origem == nos[k]) {
+            for (int i=0; i<a.n_celulas; i++) celulas.push_back(celulas_corredores[a.inicio_celulas + i]);
+        }
+        else { // atravessando a aresta ao contrário
+            for (int i=a.n_celulas-1; i>=0; i--) celulas.push_back(celulas_corredores[a.inicio_celulas + i]);
+        }
+        celulas.push_back(pos_nos[nos[k+1]]);
+    }
+}
+
+// Getters
+
+int GrafoJuncoes::get_n_nos() const {
+    return static_cast<int>(pos_nos.size());
+}
+
+int GrafoJuncoes::get_n_arestas() const {
+    return static_cast<int>(arestas.size());
+}
+
+int GrafoJuncoes::get_no_ninho() const {
+    return no_ninho;
+}
+
+int GrafoJuncoes::get_no_comida() const {
+    return no_comida;
+}
+
+Pos GrafoJuncoes::get_pos_no(const int no) const {
+    return pos_nos[no];
+}
+
+const ArestaGrafo& GrafoJuncoes::get_aresta(const int aresta) const {
+    return arestas[aresta];
+}
@@ -0,0 +1,62 @@
+#ifndef ACO_LABIRINTO_GRAFOJUNCOES_H
+#define ACO_LABIRINTO_GRAFOJUNCOES_H
+
+#include <vector>
+
+#include "Labirinto.h"
+
+// Um corredor entre dois nós do grafo. As células do meio ficam em GrafoJuncoes::celulas_corredores,
+// na ordem de origem para destino
+struct ArestaGrafo {
+    int origem, destino; // índices de nó
+    int comprimento; // passos de origem até destino (células do meio + 1)
+    int inicio_celulas, n_celulas; // fatia de celulas_corredores com as células do meio
+};
+
+// Vizinho de um nó na lista de adjacência
+struct VizinhoGrafo {
+    int aresta;
+    int no;
+};
+
+// Versão "contraída" do labirinto: os nós são as junções (células livres com 1, 3 ou 4 vizinhos livres), o ninho e
+// a comida; as arestas são os corredores de largura 1 entre eles. Assim as formigas só tomam decisões nas junções
+// em vez de gastar um passo (com cálculo de chance) em cada célula de corredor.
+// O grafo é montado uma vez no construtor, não acompanha o Labirinto::set_parede
+class GrafoJuncoes {
+public:
+    explicit GrafoJuncoes(const Labirinto& labirinto);
+
+    [[nodiscard]] int get_n_nos() const;
+    [[nodiscard]] int get_n_arestas() const;
+    [[nodiscard]] int get_no_ninho() const;
+    [[nodiscard]] int get_no_comida() const;
+    [[nodiscard]] Pos get_pos_no(int no) const;
+    [[nodiscard]] const ArestaGrafo& get_aresta(int aresta) const;
+
+    // Vizinhos do nó no formato CSR: vizinhos[inicio_vizinhos[no] .. inicio_vizinhos[no+1])
+    [[nodiscard]] const VizinhoGrafo* vizinhos_begin(const int no) const { return &vizinhos[inicio_vizinhos[no]]; }
+    [[nodiscard]] const VizinhoGrafo* vizinhos_end(const int no) const { return &vizinhos[inicio_vizinhos[no+1]]; }
+
+    // Transforma uma sequência de nós (e as arestas usadas entre eles) de volta em células do labirinto
+    void expandir_caminho(const std::vector<int>& nos, const std::vector<int>& arestas, std::vector<Pos>& celulas) const;
+    // Percorre as células de uma aresta (incluindo os dois nós das pontas), chamando f(Pos) para cada uma
+    template<class F>
+    void para_cada_celula(const int aresta, F&& f) const {
+        const ArestaGrafo& a = arestas[aresta];
+        f(pos_nos[a.origem]);
+        for (int i=0; i<a.n_celulas; i++) f(celulas_corredores[a.inicio_celulas + i]);
+        f(pos_nos[a.destino]);
+    }
+
+private:
+    std::vector<Pos> pos_nos;
+    std::vector<ArestaGrafo> arestas;
+    std::vector<Pos> celulas_corredores;
+    std::vector<int> inicio_vizinhos;
+    std::vector<VizinhoGrafo> vizinhos;
+    int no_ninho = -1, no_comida = -1;
+};
+
+
+#endif //ACO_LABIRINTO_GRAFOJUNCOES_H
@@ -1,117 +1,400 @@
 #include "Labirinto.h"
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <random>
 #include <stdexcept>
 
-#include "Formiga.h"
+#include "ArquivoLabirinto.h"
+#include "CaminhoCompacto.h"
+#include "GeradorLabirinto.h"
+#include "Serializacao.h"
 
-constexpr int CHANCE_PAREDE_ADICIONAL = 20; // 5 = 5%, 20 = 20%
+Labirinto::Labirinto(const int largura, const int altura, const bool labirinto_dificil)
+    : Labirinto(largura, altura, ConfigLabirinto{
+        labirinto_dificil ? AlgoritmoLabirinto::PILARES_DIFICIL : AlgoritmoLabirinto::PILARES,
+        std::random_device{}()}) {}
 
-Labirinto::Labirinto(const int largura, const int altura, const bool labirinto_dificil) {
+Labirinto::Labirinto(const int largura, const int altura, const ConfigLabirinto &config) {
     if (largura <= 10 || altura <= 10) {
         throw std::runtime_error("Altura e Largura devem ser maiores que 10!");
     }
-    std::cout << "LABIRINTO DIFICIL: " << std::boolalpha << labirinto_dificil << std::endl;
-    std::cout << std::noboolalpha;
+    // a semente é impressa para dar pra gerar o mesmo labirinto de novo (no clog, para não misturar com saídas
+    // que os benchmarks escrevem no cout)
+    std::clog << "LABIRINTO: algoritmo " << static_cast<int>(config.algoritmo)
+              << ", semente " << config.semente << std::endl;
 
     this->largura = largura;
     this->altura = altura;
-    this->grid.resize(largura, std::vector<int>(altura, 0));
-    this->feromonios.resize(largura, std::vector<double>(altura, 0.5));
+    this->feromonios.assign(static_cast<size_t>(largura) * altura, FEROMONIO_INICIAL);
 
-    if (!labirinto_dificil) Labirinto::criar_grid();
-    else Labirinto::criar_grid_dificil();
+    std::vector<std::uint8_t> celulas;
+    gerar_labirinto(config, largura, altura, celulas, this->pos_ninho, this->pos_comida);
+    // o gerador usa 1 byte por célula, aqui vira 1 bit (o formato do arquivo, ninho e comida ficam só nas posições)
+    auto palavras = std::make_shared<std::vector<std::uint64_t>>((celulas.size() + 63) / 64, 0);
+    for (size_t i=0; i<celulas.size(); i++) {
+        if (celulas[i] == 1) (*palavras)[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    this->paredes = std::shared_ptr<const std::uint64_t>(palavras, palavras->data());
+    this->dados_paredes = this->paredes.get();
+    this->paredes_em_vetor = true;
 }
 
-void Labirinto::criar_grid_dificil() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution dis(1, 100);
+Labirinto::Labirinto(const std::string &arquivo) {
+    ArquivoLabirinto dados = mapear_arquivo_labirinto(arquivo);
+    std::clog << "LABIRINTO: arquivo " << arquivo << " (" << dados.largura << 'x' << dados.altura << ')' << std::endl;
 
-    bool labirinto_valido = false;
+    this->largura = dados.largura;
+    this->altura = dados.altura;
+    this->pos_ninho = dados.pos_ninho;
+    this->pos_comida = dados.pos_comida;
+    this->feromonios.assign(static_cast<size_t>(largura) * altura, FEROMONIO_INICIAL);
+    this->paredes = std::move(dados.paredes);
+    this->dados_paredes = this->paredes.get();
+}
 
-    while (!labirinto_valido) {
-        for (int i=0; i<this->largura; i++) {
-            std::ranges::fill(this->grid[i], 0); // Reseta o labirinto
-        }
-        for (int i=0; i<this->largura; i++) {
-            for (int j=0; j<this->altura; j++) {
-                if ((i%2 == 0 && j%2 == 0) || i == 0 || i == this->largura-1 || j == this->altura-1 || j == 0) {
-                    this->grid[i][j] = 1; // Gera os pilares iniciais
-                }
-
-                else if ((i%2 == 0 && j%2 == 1) || (i%2 == 1 && j%2 == 0)) {
-                    if (dis(gen) <= CHANCE_PAREDE_ADICIONAL) {
-                        this->grid[i][j] = 1; // Gera os pilares aleatórios
-                    }
-                }
-            }
+void Labirinto::salvar(const std::string &arquivo) const {
+    escrever_arquivo_labirinto(arquivo, this->largura, this->altura, this->pos_ninho, this->pos_comida,
+                               this->dados_paredes);
+}
+
+void Labirinto::set_ninho_comida(const Pos &ninho, const Pos &comida) {
+    for (const Pos& p : {ninho, comida}) {
+        if (p.x < 0 || p.x >= this->largura || p.y < 0 || p.y >= this->altura) {
+            throw std::runtime_error("Posicao fora da grid!");
         }
+        if (parede_rapida(p)) throw std::runtime_error("Ninho ou comida em cima de uma parede!");
+    }
+    this->pos_ninho = ninho;
+    this->pos_comida = comida;
+}
 
-        this-> pos_ninho = {1, this->altura-2};
-        this-> pos_comida = {this->largura-2, 1};
+void Labirinto::set_parede(const Pos &p, const bool parede) {
+    if (p.x < 0 || p.x >= this->largura || p.y < 0 || p.y >= this->altura) {
+        throw std::runtime_error("Posicao fora da grid!");
+    }
+    if (parede && (p == pos_ninho || p == pos_comida)) {
+        throw std::runtime_error("Nao da pra colocar parede no ninho ou na comida!");
+    }
+    if (parede_rapida(p) == parede) return;
+
+    // cópia na escrita: outra cópia do Labirinto (ou o arquivo) ainda usa estas paredes
+    if (!paredes_em_vetor || paredes.use_count() > 1) {
+        const size_t n_palavras = (feromonios.size() + 63) / 64;
+        auto palavras = std::make_shared<std::vector<std::uint64_t>>(dados_paredes, dados_paredes + n_palavras);
+        this->paredes = std::shared_ptr<const std::uint64_t>(palavras, palavras->data());
+        this->dados_paredes = this->paredes.get();
+        this->paredes_em_vetor = true;
+    }
+    // o vetor foi criado sem const, só o ponteiro guardado é const
+    const int i = indice(p);
+    const_cast<std::uint64_t*>(dados_paredes)[i >> 6] ^= std::uint64_t{1} << (i & 63);
+    piramide.tocar(p.x, p.y);
+}
 
-        this-> grid[this-> pos_ninho.x][this-> pos_ninho.y] = 3; // ninho
-        this-> grid[this-> pos_comida.x][this-> pos_comida.y] = 2; // comida
+void Labirinto::reiniciar_feromonios() {
+    std::ranges::fill(this->feromonios, FEROMONIO_INICIAL);
+    std::ranges::fill(this->carimbo_evaporacao, 0);
+    this->n_evaporacoes = 0;
+    this->fator_evaporacao = 1.0;
+    this->feromonio_minimo = 0.0;
+    this->feromonio_alfa.clear();
+    this->alfa_cache = 0.0;
+    piramide.tocar_tudo();
+}
+
+void Labirinto::salvar_estado(EscritorBinario &escritor) const {
+    escritor.valor(largura);
+    escritor.valor(altura);
+    escritor.valor(pos_ninho);
+    escritor.valor(pos_comida);
+    escritor.valor(static_cast<std::uint8_t>(modo_evaporacao));
+
+    const std::uint64_t n_palavras = (feromonios.size() + 63) / 64;
+    escritor.valor(n_palavras);
+    escritor.bytes(dados_paredes, n_palavras * sizeof(std::uint64_t));
+
+    escritor.vetor(feromonios);
+    escritor.vetor(carimbo_evaporacao);
+    escritor.valor(n_evaporacoes);
+    escritor.valor(fator_evaporacao);
+    escritor.valor(feromonio_minimo);
+    escritor.vetor(feromonio_alfa);
+    escritor.valor(alfa_cache);
+}
+
+void Labirinto::carregar_estado(LeitorBinario &leitor) {
+    const int largura_salva = leitor.valor<int>();
+    const int altura_salva = leitor.valor<int>();
+    const Pos ninho = leitor.valor<Pos>();
+    const Pos comida = leitor.valor<Pos>();
+    if (largura_salva != largura || altura_salva != altura || !(ninho == pos_ninho) || !(comida == pos_comida)) {
+        throw std::runtime_error("O checkpoint e de outro labirinto (tamanho, ninho ou comida diferentes)!");
+    }
+    if (leitor.valor<std::uint8_t>() != static_cast<std::uint8_t>(modo_evaporacao)) {
+        throw std::runtime_error("O checkpoint usa outro modo de evaporacao!");
+    }
+
+    const size_t n_celulas = feromonios.size();
+    const std::uint64_t n_palavras = leitor.valor<std::uint64_t>();
+    if (n_palavras != (n_celulas + 63) / 64) throw std::runtime_error("Checkpoint truncado ou invalido!");
+    auto palavras = std::make_shared<std::vector<std::uint64_t>>(n_palavras);
+    leitor.bytes(palavras->data(), n_palavras * sizeof(std::uint64_t));
+    // paredes iguais: continua usando as que já tem (compartilhadas ou mapeadas)
+    if (!std::equal(palavras->begin(), palavras->end(), dados_paredes)) {
+        this->paredes = std::shared_ptr<const std::uint64_t>(palavras, palavras->data());
+        this->dados_paredes = this->paredes.get();
+        this->paredes_em_vetor = true;
+    }
+
+    leitor.vetor(feromonios);
+    leitor.vetor(carimbo_evaporacao);
+    this->n_evaporacoes = leitor.valor<std::uint32_t>();
+    this->fator_evaporacao = leitor.valor<double>();
+    this->feromonio_minimo = leitor.valor<double>();
+    leitor.vetor(feromonio_alfa);
+    this->alfa_cache = leitor.valor<double>();
+
+    const bool preguicosa = modo_evaporacao == ModoEvaporacao::PREGUICOSA;
+    if (feromonios.size() != n_celulas || carimbo_evaporacao.size() != (preguicosa ? n_celulas : 0)
+        || (!feromonio_alfa.empty() && feromonio_alfa.size() != n_celulas)) {
+        throw std::runtime_error("Checkpoint truncado ou invalido!");
+    }
+    piramide.tocar_tudo();
+}
 
-        Formiga formiga = Formiga(*this, 0, 5);
-        // gera uma formiga que vai utilizar apenas da heurística para resolver o labirinto, o tamanho_volta dela
-        // é muito grande, então se ela não encontrar a solução, é porque o problema é impossível
+void Labirinto::evaporar_feromonios(const double taxa_evaporacao, const double feromonio_minimo) {
+    const double fator = 1.0 - taxa_evaporacao;
+    piramide.evaporar(fator, feromonio_minimo);
 
-        while (!formiga.encontrou_comida() && !formiga.falhou()) {
-            formiga.mover();
+    if (this->modo_evaporacao == ModoEvaporacao::PREGUICOSA) {
+        // se os parâmetros mudarem, as evaporações antigas precisam ser aplicadas com os valores antigos
+        if (fator != this->fator_evaporacao || feromonio_minimo != this->feromonio_minimo) {
+            materializar_feromonios();
+            this->fator_evaporacao = fator;
+            this->feromonio_minimo = feromonio_minimo;
         }
-        if (formiga.encontrou_comida()) {
-            std::cout << "Labirinto valido!" << std::endl;
-            labirinto_valido = true;
+        this->n_evaporacoes++;
+        return;
+    }
+
+    if (feromonio_alfa.empty()) {
+        for (double& f : feromonios) {
+            f *= fator;
+            f = std::max(f, feromonio_minimo);
         }
+        return;
+    }
 
-        else {
-            std::cout << "Labirinto invalido, gerando novamente!" << std::endl;
+    for (size_t i=0; i<feromonios.size(); i++) {
+        const double antes = feromonios[i];
+        feromonios[i] = std::max(antes * fator, feromonio_minimo);
+        // quem já está no mínimo não muda, então só recalcula o pow de quem mudou de verdade
+        if (feromonios[i] != antes) atualizar_cache_alfa(static_cast<int>(i));
+    }
+}
+
+template<class Caminho>
+void Labirinto::depositar_caminho(const Caminho &caminho, const double intensidade, const double teto) {
+    if (caminho.empty()) {
+        return;
+    }
+    const double deposito = intensidade / static_cast<double>(caminho.size());
+    if (piramide.ativa()) {
+        for (const Pos& p : caminho) piramide.tocar(p.x, p.y);
+    }
+
+    if (this->modo_evaporacao == ModoEvaporacao::PREGUICOSA) {
+        for (const Pos& p : caminho) {
+            const int i = indice(p);
+            feromonios[i] = std::min(decair(feromonios[i], n_evaporacoes - carimbo_evaporacao[i]) + deposito, teto);
+            carimbo_evaporacao[i] = n_evaporacoes;
         }
+        return;
+    }
 
+    for (const Pos& p : caminho) {
+        const int i = indice(p);
+        feromonios[i] = std::min(feromonios[i] + deposito, teto);
+        if (!feromonio_alfa.empty()) atualizar_cache_alfa(i);
     }
 }
 
+void Labirinto::depositar_feromonios(const std::vector<Pos> &caminho, const double intensidade, const double teto) {
+    depositar_caminho(caminho, intensidade, teto);
+}
 
-void Labirinto::criar_grid() {
-    for (int i=0; i<this->largura; i++) {
-        for (int j=0; j<this->altura; j++) {
-            if ((i%2 == 0 && j%2 == 0) || i == 0 || i == this->largura-1 || j == this->altura-1 || j == 0) {
-                this->grid[i][j] = 1;
-            }
-            // se não cair nesse if, o valor continua a ser 0
+void Labirinto::depositar_feromonios(const CaminhoCompacto &caminho, const double intensidade, const double teto) {
+    depositar_caminho(caminho, intensidade, teto);
+}
+
+template<class Caminho>
+void Labirinto::misturar_caminho(const Caminho &caminho, const double peso, const double alvo) {
+    if (piramide.ativa()) {
+        for (const Pos& p : caminho) piramide.tocar(p.x, p.y);
+    }
+    for (const Pos& p : caminho) {
+        const int i = indice(p);
+        if (this->modo_evaporacao == ModoEvaporacao::PREGUICOSA) {
+            feromonios[i] = decair(feromonios[i], n_evaporacoes - carimbo_evaporacao[i]);
+            carimbo_evaporacao[i] = n_evaporacoes;
         }
+        feromonios[i] = (1.0 - peso) * feromonios[i] + peso * alvo;
+        if (!feromonio_alfa.empty()) atualizar_cache_alfa(i);
+    }
+}
+
+void Labirinto::misturar_feromonios(const std::vector<Pos> &caminho, const double peso, const double alvo) {
+    misturar_caminho(caminho, peso, alvo);
+}
+
+void Labirinto::misturar_feromonios(const CaminhoCompacto &caminho, const double peso, const double alvo) {
+    misturar_caminho(caminho, peso, alvo);
+}
+
+void Labirinto::misturar_campo(const std::vector<float> &alvo, const double peso) {
+    if (alvo.size() != feromonios.size()) {
+        throw std::runtime_error("Campo de feromonio com tamanho diferente do labirinto!");
+    }
+    materializar_feromonios();
+    for (size_t i=0; i<feromonios.size(); i++) {
+        feromonios[i] = (1.0 - peso) * feromonios[i] + peso * static_cast<double>(alvo[i]);
+        if (!feromonio_alfa.empty()) atualizar_cache_alfa(static_cast<int>(i));
     }
+    piramide.tocar_tudo();
+}
 
-    this-> pos_comida = {1, this->altura-2};
-    this-> pos_ninho = {this->largura-2, 1};
+void Labirinto::set_modo_evaporacao(const ModoEvaporacao modo) {
+    if (modo == this->modo_evaporacao) return;
 
-    this-> grid[this-> pos_ninho.x][this-> pos_ninho.y] = 3; // ninho
-    this-> grid[this-> pos_comida.x][this-> pos_comida.y] = 2; // comida
+    if (modo == ModoEvaporacao::PREGUICOSA) {
+        this->carimbo_evaporacao.assign(feromonios.size(), 0);
+        this->n_evaporacoes = 0;
+        this->feromonio_alfa.clear(); // o cache de alfa não acompanha a evaporação preguiçosa
+        this->feromonio_alfa.shrink_to_fit();
+    }
+    else {
+        materializar_feromonios(); // volta para a IMEDIATA com os valores em dia
+        this->carimbo_evaporacao.clear();
+        this->carimbo_evaporacao.shrink_to_fit();
+    }
+    this->modo_evaporacao = modo;
 }
 
-void Labirinto::evaporar_feromonios(const double taxa_evaporacao, const double feromonio_minimo) {
+void Labirinto::materializar_feromonios() {
+    if (this->modo_evaporacao != ModoEvaporacao::PREGUICOSA) return;
+
+    for (size_t i=0; i<feromonios.size(); i++) {
+        feromonios[i] = decair(feromonios[i], n_evaporacoes - carimbo_evaporacao[i]);
+        carimbo_evaporacao[i] = n_evaporacoes;
+    }
+}
+
+void Labirinto::copiar_feromonios(float* destino) const {
+    const size_t n = feromonios.size();
+    if (this->modo_evaporacao == ModoEvaporacao::IMEDIATA) {
+        for (size_t i=0; i<n; i++) destino[i] = static_cast<float>(feromonios[i]);
+        return;
+    }
+    for (size_t i=0; i<n; i++) {
+        destino[i] = static_cast<float>(decair(feromonios[i], n_evaporacoes - carimbo_evaporacao[i]));
+    }
+}
+
+void Labirinto::ativar_piramide() {
+    if (!piramide.ativa()) piramide.ativar(*this);
+}
+
+bool Labirinto::piramide_ativa() const {
+    return piramide.ativa();
+}
+
+int Labirinto::get_niveis_piramide() const {
+    // sem ativar: quantos níveis ela teria
+    int niveis = 1;
+    for (int l = largura, a = altura; l > 1 || a > 1; l = (l + 1) / 2, a = (a + 1) / 2) niveis++;
+    return niveis;
+}
+
+void Labirinto::exportar_piramide(const int nivel, const RegiaoPiramide &blocos, float *maximo, float *media) const {
+    if (nivel < 0 || nivel >= get_niveis_piramide()) {
+        throw std::runtime_error("Nivel da piramide invalido: " + std::to_string(nivel));
+    }
+    if (nivel > 0) {
+        if (!piramide.ativa()) piramide.ativar(*this);
+        piramide.exportar(*this, nivel, blocos, maximo, media);
+        return;
+    }
+    // nível 0 são as células, máximo e média são o próprio valor
+    for (int x=0; x<blocos.largura; x++) {
+        for (int y=0; y<blocos.altura; y++) {
+            const Pos p = {blocos.x + x, blocos.y + y};
+            const float v = parede_rapida(p) ? 0.0f : static_cast<float>(feromonio_rapido(p));
+            maximo[x * blocos.altura + y] = v;
+            media[x * blocos.altura + y] = v;
+        }
+    }
+}
+
+void Labirinto::preparar_heuristica(const double beta) {
+    if (heuristica_pronta(beta)) return;
+
+    // tabela nova em vez de sobrescrever, as cópias que ainda usam a do beta antigo continuam com ela
+    std::vector<double> tabela(feromonios.size());
     for (int i=0; i<this->largura; i++) {
         for (int j=0; j<this->altura; j++) {
-            feromonios[i][j] *= (1.0 - taxa_evaporacao);
-            feromonios[i][j] = std::max(feromonios[i][j], feromonio_minimo);
+            // mesma conta do Formiga::get_distancia_heuristica, só que feita uma vez por célula
+            const int dist = std::abs(i - pos_comida.x) + std::abs(j - pos_comida.y);
+            const double heuristica = 1.0 / (static_cast<double>(dist) + 1e-5);
+            tabela[i*this->altura + j] = std::pow(heuristica, beta);
         }
     }
+    this->heuristica_beta = std::make_shared<const std::vector<double>>(std::move(tabela));
+    this->dados_heuristica = this->heuristica_beta->data();
+    this->beta_heuristica = beta;
+    this->comida_heuristica = pos_comida;
 }
 
-void Labirinto::depositar_feromonios(const std::vector<Pos> &caminho, const double intensidade) {
-    if (caminho.empty()) {
-        return;
+bool Labirinto::heuristica_pronta(const double beta) const {
+    return heuristica_beta && beta == beta_heuristica && comida_heuristica == pos_comida;
+}
+
+Labirinto::DadosLeitura Labirinto::get_dados_leitura() const {
+    return {
+        dados_paredes,
+        feromonios.data(),
+        carimbo_evaporacao.empty() ? nullptr : carimbo_evaporacao.data(),
+        dados_heuristica,
+        feromonio_alfa.empty() ? nullptr : feromonio_alfa.data(),
+        n_evaporacoes,
+        fator_evaporacao,
+        feromonio_minimo,
+        modo_evaporacao == ModoEvaporacao::PREGUICOSA
+    };
+}
+
+void Labirinto::ativar_cache_feromonio_alfa(const double alfa) {
+    if (this->modo_evaporacao == ModoEvaporacao::PREGUICOSA) {
+        throw std::runtime_error("Cache de feromonio^alfa so funciona com evaporacao IMEDIATA!");
     }
-    const double deposito = intensidade / static_cast<double>(caminho.size());
-    for (const Pos& p : caminho) {
-        feromonios [p.x][p.y] += deposito;
+    if (cache_feromonio_alfa_pronto(alfa)) return;
+
+    this->alfa_cache = alfa;
+    this->feromonio_alfa.resize(feromonios.size());
+    for (size_t i=0; i<feromonios.size(); i++) {
+        atualizar_cache_alfa(static_cast<int>(i));
     }
 }
 
+bool Labirinto::cache_feromonio_alfa_pronto(const double alfa) const {
+    return !feromonio_alfa.empty() && alfa == alfa_cache;
+}
+
+void Labirinto::atualizar_cache_alfa(const int i) {
+    this->feromonio_alfa[i] = std::pow(std::max(feromonios[i], 1e-10), alfa_cache);
+}
+
 // Getters
 
 int Labirinto::get_largura() const{
@@ -130,24 +413,39 @@ Pos Labirinto::get_pos_comida() const {
     return this->pos_comida;
 }
 
+ModoEvaporacao Labirinto::get_modo_evaporacao() const {
+    return this->modo_evaporacao;
+}
+
 int Labirinto::get_valor_grid(const Pos &p) const {
     if (p.x < 0 || p.x >= this->largura || p.y < 0 || p.y >= this->altura) {
         throw std::runtime_error("Posicao fora da grid!");
     }
-    return this->grid[p.x][p.y];
+    return valor_grid_rapido(p);
 }
 
 double Labirinto::get_feromonio(const Pos &p) const {
     if (p.x < 0 || p.x >= this->largura || p.y < 0 || p.y >= this->altura) {
         throw std::runtime_error("Posicao fora da grid!");
     }
-    return this->feromonios[p.x][p.y];
+    return feromonio_rapido(p);
+}
+
+void Labirinto::set_feromonio(const Pos &p, const double valor) {
+    if (p.x < 0 || p.x >= this->largura || p.y < 0 || p.y >= this->altura) {
+        throw std::runtime_error("Posicao fora da grid!");
+    }
+    const int i = indice(p);
+    this->feromonios[i] = valor;
+    if (this->modo_evaporacao == ModoEvaporacao::PREGUICOSA) this->carimbo_evaporacao[i] = n_evaporacoes;
+    if (!feromonio_alfa.empty()) atualizar_cache_alfa(i);
+    piramide.tocar(p.x, p.y);
 }
 
 void Labirinto::print_grid() const {
     for (int i=0; i<this->largura; i++) {
         for (int j=0; j<this->altura; j++) {
-            std::cout << this->grid[i][j] << ' ';
+            std::cout << valor_grid_rapido({i, j}) << ' ';
         }
         std::cout << '\n';
     }
@@ -159,7 +457,7 @@ void Labirinto::print_feromonios() const {
 
     for (int i=0; i<this->largura; i++) {
         for (int j=0; j<this->altura; j++) {
-            std::cout << this->feromonios[i][j] << ' ';
+            std::cout << feromonio_rapido({i, j}) << ' ';
         }
         std::cout << '\n';
     }
@@ -1,7 +1,14 @@
 #ifndef ACO_LABIRINTO_LABIRINTO_H
 #define ACO_LABIRINTO_LABIRINTO_H
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "PiramideFeromonio.h"
+
 struct Pos {
     int x, y;
 
@@ -12,13 +19,85 @@ struct Pos {
     } // Isso funciona para mudar o '==' da struct, basicamente a forma de comparação entre duas structs iguais
 };
 
+// IMEDIATA: evaporar_feromonios passa por todas as células (o jeito original, bom para validar).
+// PREGUICOSA: evaporar_feromonios só conta mais uma evaporação, e cada célula guarda a última evaporação que ela
+// já "viu". A evaporação que falta é aplicada quando alguém lê ou deposita na célula, dando exatamente os mesmos
+// valores da IMEDIATA, mas o custo por iteração passa a ser proporcional aos caminhos e não ao labirinto inteiro
+enum class ModoEvaporacao { IMEDIATA, PREGUICOSA };
+
+struct ConfigLabirinto; // GeradorLabirinto.h
+class CaminhoCompacto; // CaminhoCompacto.h
+class EscritorBinario; // Serializacao.h
+class LeitorBinario;
+
+constexpr double FEROMONIO_INICIAL = 0.5; // valor de todas as células antes da primeira iteração
+
+// Copiar um Labirinto (Labirinto lab2 = lab) copia só o que muda durante a execução (feromônio e caches).
+// As paredes (até alguém usar o set_parede) e a tabela de heurística ficam compartilhadas entre as cópias, então
+// dá pra ter uma cópia por colônia (ilhas, varredura de parâmetros) sem duplicar o labirinto na memória
 class Labirinto {
 public:
+    // Sem semente: PILARES ou PILARES_DIFICIL com uma semente aleatória (que é impressa)
     Labirinto(int largura, int altura, bool labirinto_dificil);
+    Labirinto(int largura, int altura, const ConfigLabirinto& config);
+    // Abre um labirinto salvo (ArquivoLabirinto.h). As paredes são usadas direto do arquivo mapeado, sem cópia.
+    // Aceita qualquer tamanho, o limite de 10x10 é só dos geradores
+    explicit Labirinto(const std::string& arquivo);
+    // Salva as paredes, o ninho e a comida no formato do ArquivoLabirinto.h (o feromônio não vai)
+    void salvar(const std::string& arquivo) const;
+    // Troca o ninho e a comida, para resolver vários pares no mesmo labirinto (Consultas.h). Fora do labirinto ou em
+    // cima de parede dá runtime_error. A tabela da heurística depende da comida: se ela mudar, o próximo
+    // preparar_heuristica monta outra
+    void set_ninho_comida(const Pos& ninho, const Pos& comida);
+    // Abre (parede = false) ou fecha uma célula, para labirintos que mudam durante a execução. Só entre iterações.
+    // As paredes são compartilhadas com as cópias (ou são o arquivo mapeado), então a primeira alteração copia elas
+    // para este Labirinto e as outras cópias não veem a mudança. O feromônio fica como está; a heurística só
+    // depende da distância até a comida e continua valendo. Fechar o ninho ou a comida dá runtime_error.
+    // Com uma colônia rodando em cima, usar o ColoniaAco::alterar_paredes, que também atualiza o que ela guarda
+    void set_parede(const Pos& p, bool parede);
+    // Volta o feromônio de todas as células para FEROMONIO_INICIAL e zera a evaporação pendente e o cache de alfa,
+    // como um Labirinto recém-criado (sem alocar de novo)
+    void reiniciar_feromonios();
+    // Checkpoint (Checkpoint.h): as paredes (podem ter mudado com o set_parede), o feromônio e todo o estado da
+    // evaporação e do cache de alfa, bit a bit. O carregar só aceita o mesmo tamanho, ninho, comida e modo de
+    // evaporação deste Labirinto; a tabela da heurística não vai, ela sai da comida e do beta
+    void salvar_estado(EscritorBinario& escritor) const;
+    void carregar_estado(LeitorBinario& leitor);
     void print_grid() const;
     void print_feromonios() const;
     void evaporar_feromonios(double taxa_evaporacao, double feromonio_minimo);
-    void depositar_feromonios(const std::vector<Pos>& caminho, double intensidade);
+    // teto: nenhuma célula passa desse valor depois do depósito (o tau_max do MMAS)
+    void depositar_feromonios(const std::vector<Pos>& caminho, double intensidade,
+                              double teto = std::numeric_limits<double>::max());
+    void depositar_feromonios(const CaminhoCompacto& caminho, double intensidade,
+                              double teto = std::numeric_limits<double>::max());
+    // feromonio = (1 - peso)*feromonio + peso*alvo nas células do caminho (as atualizações do ACS)
+    void misturar_feromonios(const std::vector<Pos>& caminho, double peso, double alvo);
+    void misturar_feromonios(const CaminhoCompacto& caminho, double peso, double alvo);
+    // feromonio = (1 - peso)*feromonio + peso*alvo[i] em todas as células (alvo no formato do copiar_feromonios).
+    // Usado na migração entre ilhas
+    void misturar_campo(const std::vector<float>& alvo, double peso);
+    void set_modo_evaporacao(ModoEvaporacao modo);
+    [[nodiscard]] ModoEvaporacao get_modo_evaporacao() const;
+
+    // Tabelas de atratividade, para tirar o std::pow do passo das formigas.
+    // heuristica^beta só depende da célula (a comida não se mexe), então é calculada uma vez só
+    void preparar_heuristica(double beta);
+    [[nodiscard]] bool heuristica_pronta(double beta) const;
+    // Cache opcional de max(feromonio, 1e-10)^alfa, atualizado só nas células que evaporar/depositar mudaram.
+    // Só existe na evaporação IMEDIATA (na PREGUICOSA o valor muda sem ninguém escrever na célula)
+    void ativar_cache_feromonio_alfa(double alfa);
+    [[nodiscard]] bool cache_feromonio_alfa_pronto(double alfa) const;
+
+    // Pirâmide de máximo/média do feromônio para os snapshots de labirinto grande (PiramideFeromonio.h). Ativada,
+    // ela acompanha os depósitos e a evaporação e exportar um nível custa o tamanho da saída. O exportar ativa
+    // sozinho na primeira vez; ativar antes de copiar o Labirinto faz as cópias já virem com ela
+    void ativar_piramide();
+    [[nodiscard]] bool piramide_ativa() const;
+    [[nodiscard]] int get_niveis_piramide() const; // contando o nível 0 (as células)
+    // Máximo e média de cada bloco da região (em blocos do nível, ver regiao_no_nivel), na ordem x*altura + y.
+    // Bloco só de parede fica com 0. No nível 0 os dois são o valor da célula
+    void exportar_piramide(int nivel, const RegiaoPiramide& blocos, float* maximo, float* media) const;
 
     // nodiscard significa que quando a função for chamada, o valor que ela retorna é importante, então ela precisa ser
     // uma atribuição, como "variavel = Labirinto::get_largura()" ou algo do tipo
@@ -29,17 +108,99 @@ public:
 
     // passar como & faz com que não crie uma cópia da struct Pos no método. isso ajuda na otimização
     // como Pos é minúsculo, não tem tanta diferença assim, mas é mais seguro e uma boa prática de c++ de qualquer forma
+    // 0 = chão, 1 = parede, 2 = comida, 3 = ninho
     [[nodiscard]] int get_valor_grid(const Pos& p) const;
     [[nodiscard]] double get_feromonio(const Pos& p) const;
+    void set_feromonio(const Pos& p, double valor);
+    // Copia o feromônio de todas as células em float (mesma ordem x*altura + y), já com a evaporação pendente
+    // aplicada. Não mexe no Labirinto, então serve para snapshot sem materializar
+    void copiar_feromonios(float* destino) const;
+
+    // Versões sem checagem de limites para o caminho quente das formigas (quem chama garante que p está dentro).
+    // O grid é guardado em um vetor só, linha por linha (x*altura + y), então os vizinhos de y ficam lado a lado
+    [[nodiscard]] int indice(const Pos& p) const { return p.x * altura + p.y; }
+    [[nodiscard]] bool parede_rapida(const Pos& p) const {
+        const int i = indice(p);
+        return (dados_paredes[i >> 6] >> (i & 63)) & 1;
+    }
+    [[nodiscard]] int valor_grid_rapido(const Pos& p) const {
+        if (parede_rapida(p)) return 1;
+        if (p == pos_comida) return 2;
+        return p == pos_ninho ? 3 : 0;
+    }
+    [[nodiscard]] double feromonio_rapido(const Pos& p) const {
+        const int i = indice(p);
+        if (modo_evaporacao == ModoEvaporacao::IMEDIATA) return feromonios[i];
+        return decair(feromonios[i], n_evaporacoes - carimbo_evaporacao[i]);
+    }
+    [[nodiscard]] double heuristica_beta_rapida(const Pos& p) const { return dados_heuristica[indice(p)]; }
+    [[nodiscard]] double feromonio_alfa_rapido(const Pos& p) const { return feromonio_alfa[indice(p)]; }
+
+    // Ponteiros crus para quem lê várias células de uma vez (o LoteFormigas, com gather do AVX2). Valem enquanto
+    // ninguém deposita, evapora ou prepara outra tabela, ou seja, durante a fase de construção.
+    // carimbos só existe na PREGUICOSA, e o valor de verdade da célula i é decair(feromonios[i], n - carimbos[i]).
+    // heuristica é a tabela do último preparar_heuristica (conferir o beta com heuristica_pronta) e feromonio_alfa
+    // é nullptr sem o cache
+    struct DadosLeitura {
+        const std::uint64_t* paredes; // bit i = célula i é parede
+        const double* feromonios;
+        const std::uint32_t* carimbos;
+        const double* heuristica;
+        const double* feromonio_alfa;
+        std::uint32_t n_evaporacoes;
+        double fator_evaporacao, feromonio_minimo;
+        bool preguicosa;
+    };
+    [[nodiscard]] DadosLeitura get_dados_leitura() const;
 
 private:
     int altura{}, largura{}; // tem o {} para não criar lixo na memória
     Pos pos_ninho{}, pos_comida{};
 
-    std::vector<std::vector<int>> grid;
-    std::vector<std::vector<double>> feromonios;
-    void criar_grid();
-    void criar_grid_dificil();
+    // 1 bit por célula (1 = parede), 64 células por palavra. Ou é um vetor do gerador ou aponta para dentro do
+    // arquivo mapeado, o shared_ptr segura o dono dos dois jeitos. dados_paredes é o mesmo ponteiro, para o passo
+    // das formigas não passar pelo shared_ptr
+    std::shared_ptr<const std::uint64_t> paredes;
+    const std::uint64_t* dados_paredes = nullptr;
+    bool paredes_em_vetor = false; // o dono é um vetor (dá pra escrever se ninguém mais usar), não o mmap
+    std::vector<double> feromonios;
+
+    // Estado da evaporação preguiçosa
+    ModoEvaporacao modo_evaporacao = ModoEvaporacao::IMEDIATA;
+    std::vector<std::uint32_t> carimbo_evaporacao; // quantas evaporações o valor guardado na célula já inclui
+    std::uint32_t n_evaporacoes = 0;
+    double fator_evaporacao = 1.0; // 1 - taxa_evaporacao
+    double feromonio_minimo = 0.0;
+
+    // Aplica k evaporações seguidas em v, do mesmo jeito (e na mesma ordem de operações) que a IMEDIATA faria.
+    // Quando bate no mínimo ele fica lá, então o loop tem no máximo ~log(v/min) voltas
+    [[nodiscard]] double decair(double v, std::uint32_t k) const {
+        while (k-- > 0) {
+            v = std::max(v * fator_evaporacao, feromonio_minimo);
+            if (v == feromonio_minimo && fator_evaporacao < 1.0) break;
+        }
+        return v;
+    }
+    void materializar_feromonios(); // aplica a evaporação pendente em todas as células
+
+    // Corpo do depositar/misturar, igual para os dois formatos de caminho (só precisam de size() e do for).
+    // Ficam só no Labirinto.cpp, que é onde são usados
+    template<class Caminho>
+    void depositar_caminho(const Caminho& caminho, double intensidade, double teto);
+    template<class Caminho>
+    void misturar_caminho(const Caminho& caminho, double peso, double alvo);
+
+    // Tabelas de atratividade (vazias = desativadas)
+    std::shared_ptr<const std::vector<double>> heuristica_beta; // compartilhada entre cópias, como o grid
+    const double* dados_heuristica = nullptr;
+    double beta_heuristica = 0.0;
+    Pos comida_heuristica{-1, -1};
+    std::vector<double> feromonio_alfa;
+    double alfa_cache = 0.0;
+    void atualizar_cache_alfa(int i);
+
+    // mutable: o exportar (const) aplica as atualizações anotadas antes de ler
+    mutable PiramideFeromonio piramide;
 };
 
 
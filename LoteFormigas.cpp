@@ -0,0 +1,502 @@
+#include "LoteFormigas.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Aleatorio.h"
+#include "Colonia.h"
+
+#if ACO_LOTE_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// deslocamento de cada direção, na ordem do get_caminhos_validos (x-1, x+1, y-1, y+1)
+constexpr int DX[MAX_VIZINHOS] = {-1, 1, 0, 0};
+constexpr int DY[MAX_VIZINHOS] = {0, 0, -1, 1};
+
+// O mesmo Labirinto::decair, para quem lê o feromônio pelos ponteiros crus
+double decair(double v, std::uint32_t k, const double fator, const double minimo) {
+    while (k-- > 0) {
+        v = std::max(v * fator, minimo);
+        if (v == minimo && fator < 1.0) break;
+    }
+    return v;
+}
+
+// GeradorAleatorio::uniforme() em cima do estado de uma lane
+double uniforme(std::uint64_t (&gerador)[4][LARGURA_LOTE], const int lane) {
+    auto rotl = [](const std::uint64_t v, const int k) { return (v << k) | (v >> (64 - k)); };
+    std::uint64_t& s0 = gerador[0][lane];
+    std::uint64_t& s1 = gerador[1][lane];
+    std::uint64_t& s2 = gerador[2][lane];
+    std::uint64_t& s3 = gerador[3][lane];
+    const std::uint64_t resultado = rotl(s1 * 5, 7) * 9;
+    const std::uint64_t t = s1 << 17;
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = rotl(s3, 45);
+    return static_cast<double>(resultado >> 11) * 0x1.0p-53;
+}
+
+#if ACO_LOTE_AVX2
+template<int K>
+__attribute__((target("avx2"))) inline __m256i rotl_avx2(const __m256i v) {
+    return _mm256_or_si256(_mm256_slli_epi64(v, K), _mm256_srli_epi64(v, 64 - K));
+}
+
+// uint64 < 2^53 para double, exato (o AVX2 não tem essa conversão): monta 2^84 + alto*2^32 e 2^52 + baixo direto
+// nos bits do double e tira os 2^84 + 2^52 no final
+__attribute__((target("avx2"))) inline __m256d u53_para_double(const __m256i v) {
+    const __m256i alto = _mm256_or_si256(_mm256_srli_epi64(v, 32), _mm256_castpd_si256(_mm256_set1_pd(0x1.0p84)));
+    const __m256i baixo = _mm256_blend_epi32(v, _mm256_castpd_si256(_mm256_set1_pd(0x1.0p52)), 0b10101010);
+    const __m256d d_alto = _mm256_sub_pd(_mm256_castsi256_pd(alto), _mm256_set1_pd(0x1.0p84 + 0x1.0p52));
+    return _mm256_add_pd(d_alto, _mm256_castsi256_pd(baixo));
+}
+
+// decair() com máscara: cada lane faz as evaporações que faltam para ela, o loop vai até a que tem mais
+__attribute__((target("avx2"))) inline __m256d decair_avx2(__m256d f, __m256i k, const __m256d mascara,
+                                                           const double fator, const double minimo) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i um = _mm256_set1_epi64x(1);
+    const __m256d v_fator = _mm256_set1_pd(fator);
+    const __m256d v_minimo = _mm256_set1_pd(minimo);
+    __m256d pendente = _mm256_and_pd(mascara, _mm256_castsi256_pd(_mm256_cmpgt_epi64(k, zero)));
+    while (_mm256_movemask_pd(pendente)) {
+        f = _mm256_blendv_pd(f, _mm256_max_pd(_mm256_mul_pd(f, v_fator), v_minimo), pendente);
+        k = _mm256_sub_epi64(k, _mm256_and_si256(_mm256_castpd_si256(pendente), um));
+        pendente = _mm256_and_pd(pendente, _mm256_castsi256_pd(_mm256_cmpgt_epi64(k, zero)));
+        if (fator < 1.0) pendente = _mm256_andnot_pd(_mm256_cmp_pd(f, v_minimo, _CMP_EQ_OQ), pendente);
+    }
+    return f;
+}
+
+// elevar<A> de 4 valores (a mesma ordem de multiplicações, então o mesmo resultado)
+template<TipoExpoente A>
+__attribute__((target("avx2"))) inline __m256d elevar_avx2(const __m256d base, const double expoente) {
+    if constexpr (A == TipoExpoente::ZERO) return _mm256_set1_pd(1.0);
+    else if constexpr (A == TipoExpoente::UM) return base;
+    else if constexpr (A == TipoExpoente::DOIS) return _mm256_mul_pd(base, base);
+    else if constexpr (A == TipoExpoente::TRES) return _mm256_mul_pd(_mm256_mul_pd(base, base), base);
+    else if constexpr (A == TipoExpoente::QUATRO) {
+        const __m256d quadrado = _mm256_mul_pd(base, base);
+        return _mm256_mul_pd(quadrado, quadrado);
+    }
+    else {
+        alignas(32) double valores[4];
+        _mm256_store_pd(valores, base);
+        for (double& v : valores) v = std::pow(v, expoente);
+        return _mm256_load_pd(valores);
+    }
+}
+#endif
+
+}
+
+LoteFormigas::LoteFormigas(const Labirinto &labirinto, const ConfigColonia &config, const bool usar_simd)
+    :   lab(labirinto),
+        config(config),
+        usar_simd(usar_simd && simd_disponivel()),
+        largura(labirinto.get_largura()),
+        altura(labirinto.get_altura()),
+        pos_comida(labirinto.get_pos_comida()),
+        indice_ninho(labirinto.indice(labirinto.get_pos_ninho()))
+{
+    const long long n_celulas = static_cast<long long>(largura) * altura;
+    // o gather das marcas usa índice de 32 bits (celula*LARGURA_LOTE + lane)
+    if (n_celulas * LARGURA_LOTE >= (1ll << 31)) {
+        throw std::runtime_error("Labirinto grande demais para o motor em lote!");
+    }
+
+    marcas.assign(n_celulas * LARGURA_LOTE + 1, 0);
+    for (int i=0; i<largura; i++) {
+        for (int j=0; j<altura; j++) {
+            if (!lab.parede_rapida({i, j})) continue;
+            const long long inicio = static_cast<long long>(lab.indice({i, j})) * LARGURA_LOTE;
+            std::fill_n(marcas.begin() + inicio, LARGURA_LOTE, PAREDE);
+        }
+    }
+}
+
+template<class Regra>
+void LoteFormigas::construir(std::vector<Formiga> &formigas, std::atomic<int> &proxima, const int iteracao,
+                             std::vector<long long> &passos_formiga, std::vector<std::uint8_t> &timeout_formiga,
+                             std::atomic<int> *limite_poda) {
+    if (!lab.heuristica_pronta(config.beta)) {
+        throw std::runtime_error("O motor em lote precisa da tabela de heuristica preparada para o beta da colonia!");
+    }
+    // o mesmo despacho do Formiga::andar, só que para o loop inteiro
+    switch (classificar_expoente(config.alfa)) {
+        case TipoExpoente::ZERO:
+            rodar<Regra, TipoExpoente::ZERO>(formigas, proxima, iteracao, passos_formiga, timeout_formiga, limite_poda);
+            break;
+        case TipoExpoente::UM:
+            rodar<Regra, TipoExpoente::UM>(formigas, proxima, iteracao, passos_formiga, timeout_formiga, limite_poda);
+            break;
+        case TipoExpoente::DOIS:
+            rodar<Regra, TipoExpoente::DOIS>(formigas, proxima, iteracao, passos_formiga, timeout_formiga, limite_poda);
+            break;
+        case TipoExpoente::TRES:
+            rodar<Regra, TipoExpoente::TRES>(formigas, proxima, iteracao, passos_formiga, timeout_formiga, limite_poda);
+            break;
+        case TipoExpoente::QUATRO:
+            rodar<Regra, TipoExpoente::QUATRO>(formigas, proxima, iteracao, passos_formiga, timeout_formiga,
+                                               limite_poda);
+            break;
+        default:
+            rodar<Regra, TipoExpoente::GENERICO>(formigas, proxima, iteracao, passos_formiga, timeout_formiga,
+                                                 limite_poda);
+    }
+}
+
+template<class Regra, TipoExpoente A>
+void LoteFormigas::rodar(std::vector<Formiga> &formigas, std::atomic<int> &proxima, const int iteracao,
+                         std::vector<long long> &passos_formiga, std::vector<std::uint8_t> &timeout_formiga,
+                         std::atomic<int> *limite_poda) {
+    const Labirinto::DadosLeitura dados = lab.get_dados_leitura();
+    bool usar_cache_alfa = false;
+    if constexpr (A == TipoExpoente::GENERICO) usar_cache_alfa = lab.cache_feromonio_alfa_pronto(config.alfa);
+
+    int n_ativas = 0;
+    for (int lane=0; lane<LARGURA_LOTE; lane++) {
+        n_ativas += carregar(lane, formigas, proxima, iteracao, timeout_formiga);
+    }
+
+    while (n_ativas > 0) {
+#if ACO_LOTE_AVX2
+        if (usar_simd) avaliar_avx2<Regra, A>(dados, usar_cache_alfa);
+        else avaliar_escalar<Regra, A>(dados, usar_cache_alfa);
+#else
+        avaliar_escalar<Regra, A>(dados, usar_cache_alfa);
+#endif
+
+        // passo 3: o mesmo que o fim do Formiga::mover e o loop da Colonia fazem com a formiga
+        for (int lane=0; lane<LARGURA_LOTE; lane++) {
+            if (!ativa[lane]) continue;
+            Formiga& f = formigas[formiga[lane]];
+
+            if (validos[lane] == 0) {
+                if (f.pilha_solucao.size() < 2) f.m_fracassou = true;
+                else {
+#if ACO_METRICAS
+                    f.n_retrocessos++;
+#endif
+                    f.pilha_solucao.pop_back();
+                    const Pos anterior = f.pilha_solucao.back();
+                    x[lane] = anterior.x;
+                    y[lane] = anterior.y;
+                    indice[lane] = lab.indice(anterior);
+                }
+            }
+            else {
+                const int d = escolher<Regra>(lane);
+                const Pos p = {x[lane] + DX[d], y[lane] + DY[d]};
+                x[lane] = p.x;
+                y[lane] = p.y;
+                indice[lane] = lab.indice(p);
+                f.pilha_solucao.push_back(p);
+                marcas[static_cast<std::size_t>(indice[lane]) * LARGURA_LOTE + lane] = epoca[lane];
+
+                if (p == pos_comida) f.m_encontrou_comida = true;
+                else if (limite_poda) {
+                    const int restante = std::abs(p.x - pos_comida.x) + std::abs(p.y - pos_comida.y);
+                    if (static_cast<int>(f.pilha_solucao.size()) + restante
+                        > limite_poda->load(std::memory_order_relaxed)) {
+                        f.m_podada = true;
+                        f.m_fracassou = true;
+                    }
+                }
+            }
+
+            if (++passos[lane] > config.max_passos_timeout) {
+                f.m_fracassou = true;
+                timeout_formiga[formiga[lane]] = 1;
+            }
+
+            if (f.m_encontrou_comida || f.m_fracassou) {
+                f.pos_atual = {x[lane], y[lane]};
+                passos_formiga[formiga[lane]] = passos[lane];
+                if (config.poda == ModoPoda::IMEDIATA && f.m_encontrou_comida) {
+                    const int tamanho = static_cast<int>(f.pilha_solucao.size());
+                    int atual = limite_poda->load(std::memory_order_relaxed);
+                    while (tamanho < atual
+                           && !limite_poda->compare_exchange_weak(atual, tamanho, std::memory_order_relaxed)) {}
+                }
+                if (!carregar(lane, formigas, proxima, iteracao, timeout_formiga)) n_ativas--;
+            }
+        }
+    }
+}
+
+bool LoteFormigas::carregar(const int lane, std::vector<Formiga> &formigas, std::atomic<int> &proxima,
+                            const int iteracao, std::vector<std::uint8_t> &timeout_formiga) {
+    const int id = proxima.fetch_add(1, std::memory_order_relaxed);
+    if (id >= static_cast<int>(formigas.size())) {
+        ativa[lane] = 0;
+        return false;
+    }
+
+    Formiga& f = formigas[id];
+    f.reset();
+    const GeradorAleatorio gen = GeradorAleatorio::para_fluxo(config.semente, id, iteracao);
+    for (int k=0; k<4; k++) gerador[k][lane] = gen.get_estado(k);
+    timeout_formiga[id] = 0;
+
+    // a época nova invalida as marcas da formiga anterior. Quando dá a volta, limpa a coluna da lane de verdade
+    if (++epoca[lane] == PAREDE) {
+        for (std::size_t i=lane; i+1<marcas.size(); i+=LARGURA_LOTE) {
+            if (marcas[i] != PAREDE) marcas[i] = 0;
+        }
+        epoca[lane] = 1;
+    }
+    marcas[static_cast<std::size_t>(indice_ninho) * LARGURA_LOTE + lane] = epoca[lane];
+
+    const Pos ninho = lab.get_pos_ninho();
+    x[lane] = ninho.x;
+    y[lane] = ninho.y;
+    indice[lane] = indice_ninho;
+    passos[lane] = 0;
+    formiga[lane] = id;
+    ativa[lane] = -1;
+    return true;
+}
+
+template<class Regra>
+int LoteFormigas::escolher(const int lane) const {
+    const unsigned v = validos[lane];
+
+    if constexpr (std::is_same_v<Regra, RegraPseudoAleatoria>) {
+        if (sorteio[lane] < config.acs_q0) { // o mais atrativo, empate fica com o primeiro
+            int melhor = std::countr_zero(v);
+            for (int d=melhor+1; d<MAX_VIZINHOS; d++) {
+                if ((v >> d & 1) && atratividade[d][lane] > atratividade[melhor][lane]) melhor = d;
+            }
+            return melhor;
+        }
+    }
+
+    if (!(soma[lane] > 0.0)) { // sorteia igual entre os válidos, como o escolher_proximo
+        double u = sorteio[lane];
+        if constexpr (std::is_same_v<Regra, RegraPseudoAleatoria>) u = (u - config.acs_q0) / (1.0 - config.acs_q0);
+        const int n = std::popcount(v);
+        int k = std::min(static_cast<int>(u * n), n - 1);
+        unsigned restantes = v;
+        while (k-- > 0) restantes &= restantes - 1;
+        return std::countr_zero(restantes);
+    }
+
+    // a roleta para no primeiro válido em que o alvo fica antes da soma acumulada, e o último válido fica com o resto
+    const int ultimo = std::bit_width(v) - 1;
+    const unsigned r = roleta[lane] & v;
+    return r ? std::min(std::countr_zero(r), ultimo) : ultimo;
+}
+
+template<class Regra, TipoExpoente A>
+void LoteFormigas::avaliar_escalar(const Labirinto::DadosLeitura &dados, const bool usar_cache_alfa) {
+    const int deslocamento[MAX_VIZINHOS] = {-altura, altura, -1, 1};
+
+    for (int lane=0; lane<LARGURA_LOTE; lane++) {
+        validos[lane] = 0;
+        roleta[lane] = 0;
+        const bool dentro[MAX_VIZINHOS] = {x[lane] > 0, x[lane] < largura - 1, y[lane] > 0, y[lane] < altura - 1};
+
+        double acumulado = 0.0;
+        double acumulados[MAX_VIZINHOS];
+        for (int d=0; d<MAX_VIZINHOS; d++) {
+            double valor = 0.0;
+            if (ativa[lane] && dentro[d]) {
+                const int vizinho = indice[lane] + deslocamento[d];
+                const std::uint16_t marca = marcas[static_cast<std::size_t>(vizinho) * LARGURA_LOTE + lane];
+                if (marca != epoca[lane] && marca != PAREDE) {
+                    validos[lane] |= 1 << d;
+
+                    double termo_feromonio;
+                    if (usar_cache_alfa) termo_feromonio = dados.feromonio_alfa[vizinho];
+                    else {
+                        double feromonio = dados.feromonios[vizinho];
+                        if (dados.preguicosa) {
+                            feromonio = decair(feromonio, dados.n_evaporacoes - dados.carimbos[vizinho],
+                                               dados.fator_evaporacao, dados.feromonio_minimo);
+                        }
+                        if (feromonio < 1e-10) feromonio = 1e-10;
+                        termo_feromonio = elevar<A>(feromonio, config.alfa);
+                    }
+                    valor = termo_feromonio * dados.heuristica[vizinho];
+                }
+            }
+            atratividade[d][lane] = valor;
+            acumulado += valor;
+            acumulados[d] = acumulado;
+        }
+        soma[lane] = acumulado;
+        if (validos[lane] == 0) continue; // sem vizinho a formiga volta, e voltar não gasta número aleatório
+
+        sorteio[lane] = uniforme(gerador, lane);
+        double u = sorteio[lane];
+        if constexpr (std::is_same_v<Regra, RegraPseudoAleatoria>) u = (u - config.acs_q0) / (1.0 - config.acs_q0);
+        const double alvo = u * acumulado;
+        for (int d=0; d<MAX_VIZINHOS; d++) {
+            if (alvo < acumulados[d]) roleta[lane] |= 1 << d;
+        }
+    }
+}
+
+#if ACO_LOTE_AVX2
+template<class Regra, TipoExpoente A>
+void LoteFormigas::avaliar_avx2(const Labirinto::DadosLeitura &dados, const bool usar_cache_alfa) {
+    const __m256i vx = _mm256_load_si256(reinterpret_cast<const __m256i*>(x));
+    const __m256i vy = _mm256_load_si256(reinterpret_cast<const __m256i*>(y));
+    const __m256i v_indice = _mm256_load_si256(reinterpret_cast<const __m256i*>(indice));
+    const __m256i v_ativa = _mm256_load_si256(reinterpret_cast<const __m256i*>(ativa));
+    const __m256i v_epoca = _mm256_load_si256(reinterpret_cast<const __m256i*>(epoca));
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256d zero_pd = _mm256_setzero_pd();
+    const int* base_marcas = reinterpret_cast<const int*>(marcas.data());
+
+    const int deslocamento[MAX_VIZINHOS] = {-altura, altura, -1, 1};
+    const __m256i dentro[MAX_VIZINHOS] = {
+        _mm256_cmpgt_epi32(vx, zero),
+        _mm256_cmpgt_epi32(_mm256_set1_epi32(largura - 1), vx),
+        _mm256_cmpgt_epi32(vy, zero),
+        _mm256_cmpgt_epi32(_mm256_set1_epi32(altura - 1), vy)
+    };
+
+    int bits_validos[MAX_VIZINHOS];
+    __m256i algum_valido = zero;
+    __m256d acumulado[2] = {zero_pd, zero_pd}; // lanes 0-3 e 4-7
+    __m256d acumulados[MAX_VIZINHOS][2];
+
+    for (int d=0; d<MAX_VIZINHOS; d++) {
+        const __m256i vizinho = _mm256_add_epi32(v_indice, _mm256_set1_epi32(deslocamento[d]));
+        const __m256i candidato = _mm256_and_si256(dentro[d], v_ativa);
+
+        // marca da lane: 16 bits em marcas[vizinho*8 + lane], o gather lê 32 e a máscara tira a da lane seguinte
+        const __m256i pos_marca = _mm256_add_epi32(_mm256_slli_epi32(vizinho, 3), lanes);
+        __m256i marca = _mm256_mask_i32gather_epi32(zero, base_marcas, pos_marca, candidato, 2);
+        marca = _mm256_and_si256(marca, _mm256_set1_epi32(0xFFFF));
+        const __m256i ocupada = _mm256_or_si256(_mm256_cmpeq_epi32(marca, v_epoca),
+                                                _mm256_cmpeq_epi32(marca, _mm256_set1_epi32(PAREDE)));
+        const __m256i valido = _mm256_andnot_si256(ocupada, candidato);
+        bits_validos[d] = _mm256_movemask_ps(_mm256_castsi256_ps(valido));
+        algum_valido = _mm256_or_si256(algum_valido, valido);
+
+        for (int metade=0; metade<2; metade++) {
+            const __m128i viz = metade == 0 ? _mm256_castsi256_si128(vizinho) : _mm256_extracti128_si256(vizinho, 1);
+            const __m128i valido_128 = metade == 0 ? _mm256_castsi256_si128(valido)
+                                                   : _mm256_extracti128_si256(valido, 1);
+            const __m256d mascara = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(valido_128));
+
+            __m256d termo_feromonio;
+            if (usar_cache_alfa) {
+                termo_feromonio = _mm256_mask_i32gather_pd(zero_pd, dados.feromonio_alfa, viz, mascara, 8);
+            }
+            else {
+                __m256d feromonio = _mm256_mask_i32gather_pd(zero_pd, dados.feromonios, viz, mascara, 8);
+                if (dados.preguicosa) {
+                    const __m128i carimbo = _mm_mask_i32gather_epi32(_mm_setzero_si128(),
+                        reinterpret_cast<const int*>(dados.carimbos), viz, valido_128, 4);
+                    const __m128i k = _mm_sub_epi32(_mm_set1_epi32(static_cast<int>(dados.n_evaporacoes)), carimbo);
+                    feromonio = decair_avx2(feromonio, _mm256_cvtepu32_epi64(k), mascara, dados.fator_evaporacao,
+                                            dados.feromonio_minimo);
+                }
+                feromonio = _mm256_max_pd(feromonio, _mm256_set1_pd(1e-10));
+                termo_feromonio = elevar_avx2<A>(feromonio, config.alfa);
+            }
+            const __m256d heuristica = _mm256_mask_i32gather_pd(zero_pd, dados.heuristica, viz, mascara, 8);
+            const __m256d valor = _mm256_and_pd(_mm256_mul_pd(termo_feromonio, heuristica), mascara);
+
+            _mm256_store_pd(&atratividade[d][4*metade], valor);
+            acumulado[metade] = _mm256_add_pd(acumulado[metade], valor);
+            acumulados[d][metade] = acumulado[metade];
+        }
+    }
+
+    int bits_roleta[MAX_VIZINHOS] = {};
+    for (int metade=0; metade<2; metade++) {
+        _mm256_store_pd(&soma[4*metade], acumulado[metade]);
+
+        // xoshiro256** nas 4 lanes, só quem tem vizinho válido fica com o estado novo (*5 e *9 viram shift + soma)
+        const __m128i algum_128 = metade == 0 ? _mm256_castsi256_si128(algum_valido)
+                                              : _mm256_extracti128_si256(algum_valido, 1);
+        const __m256i sorteia = _mm256_cvtepi32_epi64(algum_128);
+        __m256i s[4];
+        for (int k=0; k<4; k++) s[k] = _mm256_load_si256(reinterpret_cast<const __m256i*>(&gerador[k][4*metade]));
+
+        const __m256i vezes_5 = _mm256_add_epi64(_mm256_slli_epi64(s[1], 2), s[1]);
+        const __m256i rodado = rotl_avx2<7>(vezes_5);
+        const __m256i resultado = _mm256_add_epi64(_mm256_slli_epi64(rodado, 3), rodado);
+        const __m256i t = _mm256_slli_epi64(s[1], 17);
+        __m256i novo[4];
+        novo[2] = _mm256_xor_si256(s[2], s[0]);
+        novo[3] = _mm256_xor_si256(s[3], s[1]);
+        novo[1] = _mm256_xor_si256(s[1], novo[2]);
+        novo[0] = _mm256_xor_si256(s[0], novo[3]);
+        novo[2] = _mm256_xor_si256(novo[2], t);
+        novo[3] = rotl_avx2<45>(novo[3]);
+        for (int k=0; k<4; k++) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(&gerador[k][4*metade]),
+                               _mm256_blendv_epi8(s[k], novo[k], sorteia));
+        }
+
+        const __m256d u = _mm256_mul_pd(u53_para_double(_mm256_srli_epi64(resultado, 11)), _mm256_set1_pd(0x1.0p-53));
+        _mm256_store_pd(&sorteio[4*metade], u);
+
+        // roleta: compara o alvo com as 4 somas acumuladas de uma vez
+        __m256d u_roleta = u;
+        if constexpr (std::is_same_v<Regra, RegraPseudoAleatoria>) {
+            u_roleta = _mm256_div_pd(_mm256_sub_pd(u, _mm256_set1_pd(config.acs_q0)),
+                                     _mm256_set1_pd(1.0 - config.acs_q0));
+        }
+        const __m256d alvo = _mm256_mul_pd(u_roleta, acumulado[metade]);
+        for (int d=0; d<MAX_VIZINHOS; d++) {
+            bits_roleta[d] |= _mm256_movemask_pd(_mm256_cmp_pd(alvo, acumulados[d][metade], _CMP_LT_OQ)) << 4*metade;
+        }
+    }
+
+    for (int lane=0; lane<LARGURA_LOTE; lane++) {
+        std::uint8_t v = 0, r = 0;
+        for (int d=0; d<MAX_VIZINHOS; d++) {
+            v |= (bits_validos[d] >> lane & 1) << d;
+            r |= (bits_roleta[d] >> lane & 1) << d;
+        }
+        validos[lane] = v;
+        roleta[lane] = r;
+    }
+}
+#endif
+
+void LoteFormigas::atualizar_parede(const Pos &p) {
+    // aberta volta para 0, que nenhuma época usa
+    const std::uint16_t marca = lab.parede_rapida(p) ? PAREDE : 0;
+    std::fill_n(marcas.begin() + static_cast<long long>(lab.indice(p)) * LARGURA_LOTE, LARGURA_LOTE, marca);
+}
+
+void LoteFormigas::atualizar_ninho_comida() {
+    pos_comida = lab.get_pos_comida();
+    indice_ninho = lab.indice(lab.get_pos_ninho());
+}
+
+bool LoteFormigas::usando_simd() const {
+    return usar_simd;
+}
+
+bool LoteFormigas::simd_disponivel() {
+#if ACO_LOTE_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// as duas regras que existem, como no Formiga::mover
+template void LoteFormigas::construir<RegraProporcional>(std::vector<Formiga>&, std::atomic<int>&, int,
+    std::vector<long long>&, std::vector<std::uint8_t>&, std::atomic<int>*);
+template void LoteFormigas::construir<RegraPseudoAleatoria>(std::vector<Formiga>&, std::atomic<int>&, int,
+    std::vector<long long>&, std::vector<std::uint8_t>&, std::atomic<int>*);
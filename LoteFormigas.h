@@ -0,0 +1,113 @@
+#ifndef ACO_LABIRINTO_LOTEFORMIGAS_H
+#define ACO_LABIRINTO_LOTEFORMIGAS_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Formiga.h"
+#include "Labirinto.h"
+
+// Com ACO_SIMD=0 (opção do CMake) o AVX2 nem é compilado e o LOTE usa sempre a versão sem SIMD
+#ifndef ACO_SIMD
+#define ACO_SIMD 1
+#endif
+#if ACO_SIMD && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ACO_LOTE_AVX2 1
+#else
+#define ACO_LOTE_AVX2 0
+#endif
+
+struct ConfigColonia; // Colonia.h
+
+// Como a fase de construção anda as formigas.
+// ESCALAR: cada formiga anda sozinha até o fim (Formiga::mover), o jeito original.
+// LOTE: LARGURA_LOTE formigas andam juntas, um passo de cada por vez (LoteFormigas). Usa AVX2 se foi compilado com
+//       ACO_SIMD e o processador tiver, senão o mesmo algoritmo em C++ normal.
+// LOTE_SEM_SIMD: LOTE sempre na versão sem AVX2 (para comparar as duas).
+// Os três dão exatamente os mesmos caminhos: cada formiga usa o mesmo fluxo aleatório e as mesmas contas, na mesma
+// ordem, que o Formiga::mover faria
+enum class MotorFormigas { ESCALAR, LOTE, LOTE_SEM_SIMD };
+
+constexpr int LARGURA_LOTE = 8; // formigas por lote (8 índices de 32 bits num registrador AVX2)
+
+// Motor da construção em lote. O estado das formigas que estão andando (posição, gerador, época dos visitados) fica
+// em vetores de LARGURA_LOTE posições (SoA), e cada passo do lote:
+//   1) avalia os 4 vizinhos das 8 formigas de uma vez: gather das marcas de visitado/parede, do feromônio (com a
+//      evaporação preguiçosa aplicada com máscara) e da heurística, atratividade e soma acumulada;
+//   2) sorteia o número de cada formiga (xoshiro em SoA, só avança o gerador de quem tem vizinho livre) e compara
+//      com as somas acumuladas, o que já dá o resultado da roleta;
+//   3) aplica o passo de cada formiga (empilhar, ou desempilhar se não tinha vizinho) no caminho dela.
+// As formigas sem vizinho livre (retrocesso) passam pelos passos 1 e 2 só com a máscara zerada. Quando uma formiga
+// termina, a próxima da fila entra no lugar dela, então o lote não fica esperando a mais lenta.
+// Os visitados de todas as lanes ficam num vetor só, intercalados (marcas[celula*LARGURA_LOTE + lane]), com as
+// paredes marcadas com PAREDE em todas as lanes: um gather só responde "parede ou já visitada". São 16 bytes por
+// célula por lote (um lote por thread), independente do número de formigas
+class LoteFormigas {
+public:
+    LoteFormigas(const Labirinto& labirinto, const ConfigColonia& config, bool usar_simd);
+
+    // Anda as formigas formigas[proxima++] até a fila acabar. Várias threads podem dividir a mesma fila, cada uma
+    // com o seu lote. Preenche passos_formiga e timeout_formiga e aperta limite_poda (se não for nullptr) como o
+    // loop da Colonia faria
+    template<class Regra>
+    void construir(std::vector<Formiga>& formigas, std::atomic<int>& proxima, int iteracao,
+                   std::vector<long long>& passos_formiga, std::vector<std::uint8_t>& timeout_formiga,
+                   std::atomic<int>* limite_poda);
+
+    // Refaz as marcas da célula depois que ela virou parede ou foi aberta (Labirinto::set_parede)
+    void atualizar_parede(const Pos& p);
+    // Pega o ninho/comida atuais do Labirinto (depois de um set_ninho_comida). Só entre duas construções
+    void atualizar_ninho_comida();
+
+    [[nodiscard]] bool usando_simd() const;
+    // Se esta versão foi compilada com AVX2 e o processador tem
+    [[nodiscard]] static bool simd_disponivel();
+
+private:
+    static constexpr std::uint16_t PAREDE = 0xFFFF; // marca das paredes, as épocas nunca chegam nela
+
+    const Labirinto& lab;
+    const ConfigColonia& config;
+    bool usar_simd;
+    int largura, altura;
+    Pos pos_comida;
+    int indice_ninho;
+
+    std::vector<std::uint16_t> marcas; // +1 posição no final, o gather lê 32 bits
+
+    // Estado das lanes (SoA)
+    alignas(32) std::int32_t x[LARGURA_LOTE]{}, y[LARGURA_LOTE]{}, indice[LARGURA_LOTE]{};
+    alignas(32) std::int32_t ativa[LARGURA_LOTE]{}; // -1 = tem formiga andando, 0 = vazia (já no formato de máscara)
+    alignas(32) std::uint32_t epoca[LARGURA_LOTE]{};
+    alignas(32) std::uint64_t gerador[4][LARGURA_LOTE]{}; // estado do xoshiro256** de cada lane
+    int formiga[LARGURA_LOTE]{};
+    long long passos[LARGURA_LOTE]{};
+
+    // Saída da avaliação de um passo
+    alignas(32) double atratividade[MAX_VIZINHOS][LARGURA_LOTE]{}; // 0 nos vizinhos inválidos
+    alignas(32) double soma[LARGURA_LOTE]{};
+    alignas(32) double sorteio[LARGURA_LOTE]{}; // o uniforme() da formiga, sem o ajuste do q0
+    std::uint8_t validos[LARGURA_LOTE]{}; // bit d = vizinho d livre (direções na ordem do get_caminhos_validos)
+    std::uint8_t roleta[LARGURA_LOTE]{}; // bit d = o alvo da roleta ficou antes da soma acumulada até d
+
+    template<class Regra, TipoExpoente A>
+    void rodar(std::vector<Formiga>& formigas, std::atomic<int>& proxima, int iteracao,
+               std::vector<long long>& passos_formiga, std::vector<std::uint8_t>& timeout_formiga,
+               std::atomic<int>* limite_poda);
+    bool carregar(int lane, std::vector<Formiga>& formigas, std::atomic<int>& proxima, int iteracao,
+                  std::vector<std::uint8_t>& timeout_formiga);
+    template<class Regra>
+    [[nodiscard]] int escolher(int lane) const;
+
+    // As duas versões do passo 1 e 2, com o mesmo resultado
+    template<class Regra, TipoExpoente A>
+    void avaliar_escalar(const Labirinto::DadosLeitura& dados, bool usar_cache_alfa);
+#if ACO_LOTE_AVX2
+    template<class Regra, TipoExpoente A>
+    __attribute__((target("avx2"))) void avaliar_avx2(const Labirinto::DadosLeitura& dados, bool usar_cache_alfa);
+#endif
+};
+
+
+#endif //ACO_LABIRINTO_LOTEFORMIGAS_H
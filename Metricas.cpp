@@ -0,0 +1,68 @@
+#include "Metricas.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+void resumir_tamanhos(std::vector<int> &tamanhos, MetricasIteracao &metricas) {
+    if (tamanhos.empty()) return;
+
+    // nth_element em vez de sort, só precisa de dois percentis
+    const auto percentil = [&tamanhos](const double p) {
+        const size_t k = static_cast<size_t>(p * static_cast<double>(tamanhos.size() - 1));
+        std::nth_element(tamanhos.begin(), tamanhos.begin() + static_cast<long>(k), tamanhos.end());
+        return tamanhos[k];
+    };
+    metricas.tamanho_p50 = percentil(0.5);
+    metricas.tamanho_p90 = percentil(0.9);
+
+    const auto [menor, maior] = std::ranges::minmax_element(tamanhos);
+    metricas.tamanho_min = *menor;
+    metricas.tamanho_max = *maior;
+    metricas.tamanho_medio = std::accumulate(tamanhos.begin(), tamanhos.end(), 0.0)
+        / static_cast<double>(tamanhos.size());
+}
+
+GravadorMetricas::GravadorMetricas(const std::string &caminho, const int continuar_da_iteracao) {
+    // as linhas de antes da retomada (todas começam com {"iteracao":N)
+    std::vector<std::string> anteriores;
+    if (continuar_da_iteracao >= 0) {
+        std::ifstream existente(caminho);
+        const std::string prefixo = "{\"iteracao\":";
+        std::string linha;
+        while (std::getline(existente, linha)) {
+            if (linha.rfind(prefixo, 0) != 0 || linha.back() != '}') continue; // a última pode ter ficado pela metade
+            if (std::atoi(linha.c_str() + prefixo.size()) < continuar_da_iteracao) anteriores.push_back(linha);
+        }
+    }
+    arquivo.open(caminho);
+    for (const std::string& linha : anteriores) arquivo << linha << '\n';
+    if (!arquivo.is_open()) {
+        std::cerr << "ERRO! Nao foi possivel criar o arquivo " << caminho << std::endl;
+    }
+}
+
+void GravadorMetricas::registrar(const MetricasIteracao &m) {
+    if (!arquivo.is_open()) return;
+
+    // '\n' e não std::endl: o arquivo só é descarregado quando o buffer enche ou no final
+    arquivo << "{\"iteracao\":" << m.iteracao
+            << ",\"t_construcao\":" << m.t_construcao
+            << ",\"t_evaporacao\":" << m.t_evaporacao
+            << ",\"t_ordenacao\":" << m.t_ordenacao
+            << ",\"t_deposito\":" << m.t_deposito
+            << ",\"t_snapshot\":" << m.t_snapshot
+            << ",\"passos\":" << m.passos
+            << ",\"retrocessos\":" << m.retrocessos
+            << ",\"sucessos\":" << m.sucessos
+            << ",\"timeouts\":" << m.timeouts
+            << ",\"podadas\":" << m.podadas
+            << ",\"falhas\":" << m.falhas
+            << ",\"tamanho_min\":" << m.tamanho_min
+            << ",\"tamanho_p50\":" << m.tamanho_p50
+            << ",\"tamanho_p90\":" << m.tamanho_p90
+            << ",\"tamanho_max\":" << m.tamanho_max
+            << ",\"tamanho_medio\":" << m.tamanho_medio
+            << ",\"melhor_global\":" << m.melhor_global
+            << "}\n";
+}
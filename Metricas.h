@@ -0,0 +1,77 @@
+#ifndef ACO_LABIRINTO_METRICAS_H
+#define ACO_LABIRINTO_METRICAS_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Instrumentação por iteração. Com ACO_METRICAS=0 (opção do CMake) os contadores e cronômetros viram código vazio
+// e nada é medido; os campos de MetricasIteracao continuam existindo, só ficam zerados
+#ifndef ACO_METRICAS
+#define ACO_METRICAS 1
+#endif
+constexpr bool METRICAS_ATIVAS = ACO_METRICAS != 0;
+
+struct MetricasIteracao {
+    int iteracao = 0;
+
+    // tempo em segundos de cada fase
+    double t_construcao = 0.0;
+    double t_evaporacao = 0.0;
+    double t_ordenacao = 0.0;
+    double t_deposito = 0.0;
+    double t_snapshot = 0.0; // preenchido por quem salva (main)
+
+    long long passos = 0;
+    long long retrocessos = 0; // vezes que uma formiga voltou de um beco sem saída
+    int sucessos = 0;
+    int timeouts = 0; // passaram do max_passos_timeout
+    int podadas = 0; // desistiram porque não iam empatar com o melhor global (ModoPoda)
+    int falhas = 0; // ficaram sem caminho nenhum (voltaram até o ninho)
+
+    // distribuição do tamanho dos caminhos de quem achou comida
+    int tamanho_min = -1, tamanho_p50 = -1, tamanho_p90 = -1, tamanho_max = -1;
+    double tamanho_medio = 0.0;
+
+    int melhor_global = -1;
+};
+
+// Preenche os campos de tamanho a partir dos tamanhos dos caminhos (a ordem do vetor é alterada)
+void resumir_tamanhos(std::vector<int>& tamanhos, MetricasIteracao& metricas);
+
+// Soma o tempo do bloco em destino quando sai de escopo
+#if ACO_METRICAS
+class Cronometro {
+public:
+    explicit Cronometro(double& destino) : destino(destino), inicio(std::chrono::steady_clock::now()) {}
+    ~Cronometro() {
+        destino += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+    Cronometro(const Cronometro&) = delete;
+    Cronometro& operator=(const Cronometro&) = delete;
+
+private:
+    double& destino;
+    std::chrono::steady_clock::time_point inicio;
+};
+#else
+class Cronometro {
+public:
+    explicit Cronometro(double&) {}
+};
+#endif
+
+// Escreve uma linha JSON por iteração. continuar_da_iteracao >= 0 (retomada de um checkpoint): as linhas das
+// iterações anteriores que já estão no arquivo ficam, as dessa iteração em diante são descartadas
+class GravadorMetricas {
+public:
+    explicit GravadorMetricas(const std::string& caminho, int continuar_da_iteracao = -1);
+    void registrar(const MetricasIteracao& metricas);
+
+private:
+    std::ofstream arquivo;
+};
+
+
+#endif //ACO_LABIRINTO_METRICAS_H
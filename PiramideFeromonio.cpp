@@ -0,0 +1,201 @@
+#include "PiramideFeromonio.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "Labirinto.h"
+
+void PiramideFeromonio::ativar(const Labirinto &lab) {
+    niveis.clear();
+    int largura = lab.get_largura(), altura = lab.get_altura();
+    while (largura > 1 || altura > 1) {
+        largura = (largura + 1) / 2;
+        altura = (altura + 1) / 2;
+        Nivel nivel;
+        nivel.largura = largura;
+        nivel.altura = altura;
+        const size_t n = static_cast<size_t>(largura) * altura;
+        nivel.maximo.assign(n, 0.0);
+        nivel.soma.assign(n, 0.0);
+        nivel.carimbo.assign(n, 0);
+        nivel.livres.assign(n, 0);
+        nivel.no_minimo.assign(n, 0);
+        niveis.push_back(std::move(nivel));
+    }
+    sujos.clear();
+    reconstruir(lab);
+}
+
+void PiramideFeromonio::evaporar(const double fator_evaporacao, const double feromonio_minimo) {
+    if (niveis.empty()) return;
+    // parâmetros novos mudam quando cada célula chega no mínimo: refaz tudo a partir das células, que o Labirinto
+    // já deixa em dia com os parâmetros antigos
+    if (fator_evaporacao != this->fator_evaporacao || feromonio_minimo != this->feromonio_minimo) {
+        this->fator_evaporacao = fator_evaporacao;
+        this->feromonio_minimo = feromonio_minimo;
+        refazer_tudo = true;
+        sujos.clear();
+    }
+    n_evaporacoes++;
+}
+
+void PiramideFeromonio::decair(double &maximo, double &soma, const std::uint32_t livres, std::uint32_t k) const {
+    if (livres == 0) return;
+    while (k-- > 0) {
+        // o máximo faz exatamente as contas do Labirinto::decair
+        maximo = std::max(maximo * fator_evaporacao, feromonio_minimo);
+        soma *= fator_evaporacao;
+        if (maximo == feromonio_minimo && fator_evaporacao < 1.0) break; // a soma já é 0
+    }
+}
+
+std::uint32_t PiramideFeromonio::evaporacoes_ate_minimo(const double v) const {
+    if (fator_evaporacao <= 0.0) return 1;
+    if (fator_evaporacao >= 1.0 || feromonio_minimo <= 0.0) return NUNCA;
+    // a menor k com v*fator^k <= minimo. O log dá a conta quase certa e o pow acerta a borda
+    const double estimativa = std::ceil(std::log(feromonio_minimo / v) / std::log(fator_evaporacao));
+    if (!(estimativa < 1e9)) return NUNCA;
+    auto k = static_cast<std::uint32_t>(std::max(1.0, estimativa));
+    while (k > 1 && v * std::pow(fator_evaporacao, k - 1) <= feromonio_minimo) k--;
+    while (v * std::pow(fator_evaporacao, k) > feromonio_minimo) k++;
+    return k;
+}
+
+void PiramideFeromonio::em_dia(Nivel &nivel, const int i) {
+    decair(nivel.maximo[i], nivel.soma[i], nivel.livres[i], n_evaporacoes - nivel.carimbo[i]);
+    nivel.carimbo[i] = n_evaporacoes;
+}
+
+void PiramideFeromonio::refazer_folha(const Labirinto &lab, const int i) {
+    Nivel& nivel = niveis[0];
+    const int bx = i / nivel.altura, by = i % nivel.altura;
+    double maximo = 0.0, soma = 0.0;
+    std::uint32_t livres = 0, no_minimo = 0, proxima = NUNCA;
+    for (int x=2*bx; x<std::min(2*bx + 2, lab.get_largura()); x++) {
+        for (int y=2*by; y<std::min(2*by + 2, lab.get_altura()); y++) {
+            if (lab.parede_rapida({x, y})) continue;
+            const double v = lab.feromonio_rapido({x, y});
+            maximo = livres == 0 ? v : std::max(maximo, v);
+            livres++;
+            if (v <= feromonio_minimo) {
+                no_minimo++;
+                continue;
+            }
+            soma += v;
+            const std::uint32_t k = evaporacoes_ate_minimo(v);
+            if (k != NUNCA) proxima = std::min(proxima, n_evaporacoes + k);
+        }
+    }
+    nivel.maximo[i] = maximo;
+    nivel.soma[i] = soma;
+    nivel.livres[i] = livres;
+    nivel.no_minimo[i] = no_minimo;
+    nivel.carimbo[i] = n_evaporacoes;
+    // se já tem uma mais cedo na fila, ela refaz o bloco e agenda de novo quando chegar
+    if (proxima < proxima_no_minimo[i]) {
+        proxima_no_minimo[i] = proxima;
+        chegadas_no_minimo.emplace(proxima, i);
+    }
+}
+
+void PiramideFeromonio::refazer_bloco(const int k, const int i) {
+    Nivel& filhos = niveis[k-1];
+    Nivel& nivel = niveis[k];
+    const int bx = i / nivel.altura, by = i % nivel.altura;
+    double maximo = 0.0, soma = 0.0;
+    std::uint32_t livres = 0, no_minimo = 0;
+    for (int x=2*bx; x<std::min(2*bx + 2, filhos.largura); x++) {
+        for (int y=2*by; y<std::min(2*by + 2, filhos.altura); y++) {
+            const int f = x * filhos.altura + y;
+            if (filhos.livres[f] == 0) continue;
+            em_dia(filhos, f);
+            maximo = livres == 0 ? filhos.maximo[f] : std::max(maximo, filhos.maximo[f]);
+            soma += filhos.soma[f];
+            livres += filhos.livres[f];
+            no_minimo += filhos.no_minimo[f];
+        }
+    }
+    nivel.maximo[i] = maximo;
+    nivel.soma[i] = soma;
+    nivel.livres[i] = livres;
+    nivel.no_minimo[i] = no_minimo;
+    nivel.carimbo[i] = n_evaporacoes;
+}
+
+void PiramideFeromonio::reconstruir(const Labirinto &lab) {
+    proxima_no_minimo.assign(niveis[0].maximo.size(), NUNCA);
+    chegadas_no_minimo = {};
+    for (int i=0; i<static_cast<int>(niveis[0].maximo.size()); i++) refazer_folha(lab, i);
+    for (int k=1; k<static_cast<int>(niveis.size()); k++) {
+        for (int i=0; i<static_cast<int>(niveis[k].maximo.size()); i++) refazer_bloco(k, i);
+    }
+    refazer_tudo = false;
+}
+
+void PiramideFeromonio::aplicar_pendentes(const Labirinto &lab) {
+    // blocos em que alguma célula chegou no mínimo desde a última vez
+    while (!chegadas_no_minimo.empty() && chegadas_no_minimo.top().first <= n_evaporacoes) {
+        const auto [evaporacao, i] = chegadas_no_minimo.top();
+        chegadas_no_minimo.pop();
+        if (proxima_no_minimo[i] != evaporacao) continue;
+        proxima_no_minimo[i] = NUNCA;
+        if (!refazer_tudo) sujos.push_back(i);
+    }
+    if (refazer_tudo) {
+        sujos.clear();
+        reconstruir(lab);
+        return;
+    }
+    if (sujos.empty()) return;
+
+    auto sem_repetidos = [this] {
+        std::ranges::sort(sujos);
+        const auto repetidos = std::ranges::unique(sujos);
+        sujos.erase(repetidos.begin(), repetidos.end());
+    };
+    sem_repetidos();
+    for (const int i : sujos) refazer_folha(lab, i);
+    // sobe um nível de cada vez, os sujos viram os pais deles
+    for (int k=1; k<static_cast<int>(niveis.size()); k++) {
+        const int altura_filhos = niveis[k-1].altura;
+        for (int& i : sujos) i = (i / altura_filhos / 2) * niveis[k].altura + (i % altura_filhos) / 2;
+        sem_repetidos();
+        for (const int i : sujos) refazer_bloco(k, i);
+    }
+    sujos.clear();
+}
+
+void PiramideFeromonio::exportar(const Labirinto &lab, const int nivel, const RegiaoPiramide &blocos,
+                                 float *maximo, float *media) {
+    aplicar_pendentes(lab);
+    const Nivel& dados = niveis[nivel - 1];
+    for (int x=0; x<blocos.largura; x++) {
+        for (int y=0; y<blocos.altura; y++) {
+            const int i = (blocos.x + x) * dados.altura + blocos.y + y;
+            const int saida = x * blocos.altura + y;
+            // cópia: a leitura não mexe no carimbo, então dá pra exportar quantas vezes quiser
+            double bloco_maximo = dados.maximo[i], bloco_soma = dados.soma[i];
+            decair(bloco_maximo, bloco_soma, dados.livres[i], n_evaporacoes - dados.carimbo[i]);
+            bloco_soma += feromonio_minimo * dados.no_minimo[i];
+            maximo[saida] = static_cast<float>(bloco_maximo);
+            media[saida] = dados.livres[i] == 0 ? 0.0f : static_cast<float>(bloco_soma / dados.livres[i]);
+        }
+    }
+}
+
+RegiaoPiramide regiao_no_nivel(const RegiaoPiramide &celulas, const int nivel, const int largura, const int altura) {
+    const int x1 = celulas.largura > 0 ? celulas.x + celulas.largura : largura;
+    const int y1 = celulas.altura > 0 ? celulas.y + celulas.altura : altura;
+    if (nivel < 0 || nivel > 30 || celulas.x < 0 || celulas.y < 0 || x1 > largura || y1 > altura || celulas.x >= x1
+        || celulas.y >= y1) {
+        throw std::runtime_error("Regiao da piramide fora do labirinto ou vazia!");
+    }
+    const int lado = 1 << nivel;
+    RegiaoPiramide blocos;
+    blocos.x = celulas.x >> nivel;
+    blocos.y = celulas.y >> nivel;
+    blocos.largura = (x1 + lado - 1) / lado - blocos.x;
+    blocos.altura = (y1 + lado - 1) / lado - blocos.y;
+    return blocos;
+}
@@ -0,0 +1,102 @@
+#ifndef ACO_LABIRINTO_PIRAMIDEFEROMONIO_H
+#define ACO_LABIRINTO_PIRAMIDEFEROMONIO_H
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+class Labirinto; // Labirinto.h
+
+// Um retângulo de células (ou de blocos de um nível da pirâmide). largura/altura <= 0 = até o fim do labirinto
+struct RegiaoPiramide {
+    int x = 0, y = 0;
+    int largura = 0, altura = 0;
+};
+
+// Pirâmide do feromônio para visualizar labirinto grande: o nível k tem um valor por bloco de 2^k x 2^k células
+// (o nível 0 são as próprias células, que ficam no Labirinto), com o máximo e a soma do feromônio das células
+// livres do bloco. Cada nível é um grid de ceil(largura/2^k) x ceil(altura/2^k), na mesma ordem x*altura + y.
+// Fica dentro do Labirinto e é atualizada aos poucos:
+//   - depósito/mistura/set_feromonio/set_parede só anotam o bloco 2x2 da célula (tocar). Antes de exportar, os
+//     blocos anotados são refeitos a partir das células e cada nível de cima a partir dos 4 filhos, então o custo
+//     é proporcional às células que mudaram vezes o número de níveis;
+//   - a evaporação só conta mais uma (igual à evaporação preguiçosa do Labirinto). Cada bloco guarda até qual
+//     evaporação ele está em dia e o resto é aplicado na leitura: o máximo com as mesmas contas da célula; a soma
+//     é separada em soma das células acima do mínimo (que só é multiplicada pelo fator) mais minimo vezes as que
+//     já estão nele. Para essa conta continuar exata, cada bloco do nível 1 calcula em qual evaporação a próxima
+//     célula dele chega no mínimo e nessa hora ele é anotado como se tivesse sido tocado, então máximo e média
+//     saem exatos (a menos do arredondamento). O custo a mais é proporcional às células que chegam no mínimo
+// Assim exportar um nível ou uma região custa o tamanho da saída, não a área do labirinto.
+// Memória: ~12 bytes por célula (somando todos os níveis e a fila), um pouco mais que o feromônio
+class PiramideFeromonio {
+public:
+    // Monta todos os níveis a partir do Labirinto (custo da área inteira, uma vez só)
+    void ativar(const Labirinto& lab);
+    [[nodiscard]] bool ativa() const { return !niveis.empty(); }
+    // Contando o nível 0 (as células)
+    [[nodiscard]] int get_n_niveis() const { return static_cast<int>(niveis.size()) + 1; }
+
+    // A célula (x, y) mudou de valor ou virou/deixou de ser parede
+    void tocar(const int x, const int y) {
+        if (niveis.empty() || refazer_tudo) return;
+        sujos.push_back((x >> 1) * niveis[0].altura + (y >> 1));
+        // mudou quase tudo (ColoniaGrafo exporta o labirinto inteiro, por exemplo): sai mais barato refazer
+        if (sujos.size() > niveis[0].maximo.size()) {
+            refazer_tudo = true;
+            sujos.clear();
+        }
+    }
+    // Todas as células mudaram (reiniciar, mistura de ilhas, checkpoint)
+    void tocar_tudo() { refazer_tudo = !niveis.empty(); }
+    // Uma evaporação com estes parâmetros, como o Labirinto::evaporar_feromonios
+    void evaporar(double fator_evaporacao, double feromonio_minimo);
+
+    // Escreve o máximo e a média dos blocos da região (em blocos do nível, já dentro dele), nivel >= 1.
+    // Aplica antes o que foi anotado pelo tocar
+    void exportar(const Labirinto& lab, int nivel, const RegiaoPiramide& blocos, float* maximo, float* media);
+
+private:
+    struct Nivel {
+        int largura = 0, altura = 0;
+        std::vector<double> maximo;
+        std::vector<double> soma; // só das células acima do mínimo
+        std::vector<std::uint32_t> carimbo; // até qual evaporação o bloco está em dia
+        std::vector<std::uint32_t> livres; // células livres no bloco
+        std::vector<std::uint32_t> no_minimo; // das livres, as que já estão no feromonio_minimo
+    };
+    std::vector<Nivel> niveis; // niveis[k-1] é o nível k
+
+    static constexpr std::uint32_t NUNCA = std::numeric_limits<std::uint32_t>::max();
+    // Evaporação em que a próxima célula de cada bloco do nível 1 chega no mínimo (NUNCA se nenhuma chega), e a
+    // fila dessas evaporações, a menor primeiro. Entrada da fila que não bate com o proxima_no_minimo é velha
+    std::vector<std::uint32_t> proxima_no_minimo;
+    using EventoMinimo = std::pair<std::uint32_t, int>; // evaporação, bloco do nível 1
+    std::priority_queue<EventoMinimo, std::vector<EventoMinimo>, std::greater<>> chegadas_no_minimo;
+
+    std::vector<int> sujos; // blocos do nível 1 a refazer (com repetição)
+    bool refazer_tudo = false;
+
+    std::uint32_t n_evaporacoes = 0;
+    double fator_evaporacao = 1.0;
+    double feromonio_minimo = 0.0;
+
+    // Aplica k evaporações no bloco (sem nenhuma célula chegar no mínimo no meio, o proxima_no_minimo garante)
+    void decair(double& maximo, double& soma, std::uint32_t livres, std::uint32_t k) const;
+    // Quantas evaporações a célula com feromônio v (> mínimo) leva para chegar no mínimo, NUNCA se não chega
+    [[nodiscard]] std::uint32_t evaporacoes_ate_minimo(double v) const;
+    void em_dia(Nivel& nivel, int i); // aplica a evaporação que falta no bloco i
+    void refazer_folha(const Labirinto& lab, int i); // bloco i do nível 1, a partir das células
+    void refazer_bloco(int k, int i); // bloco i do nível k+1, a partir dos 4 filhos
+    void reconstruir(const Labirinto& lab);
+    void aplicar_pendentes(const Labirinto& lab);
+};
+
+// A região de células vista em blocos do nível (arredonda para fora). Região vazia ou fora do labirinto dá
+// runtime_error
+[[nodiscard]] RegiaoPiramide regiao_no_nivel(const RegiaoPiramide& celulas, int nivel, int largura, int altura);
+
+
+#endif //ACO_LABIRINTO_PIRAMIDEFEROMONIO_H
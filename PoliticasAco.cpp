@@ -0,0 +1,139 @@
+#include "PoliticasAco.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Colonia.h"
+
+// Elitista
+
+PoliticaElitista::PoliticaElitista(Labirinto &labirinto, const ConfigColonia &config)
+    :   lab(labirinto),
+        config(config) {}
+
+int PoliticaElitista::n_depositantes() const {
+    return config.elite;
+}
+
+void PoliticaElitista::evaporar() {
+    lab.evaporar_feromonios(config.taxa_evaporacao, config.min_feromonio);
+}
+
+void PoliticaElitista::depositar(const std::vector<CaminhoCompacto> &elite, const int n_elite,
+                                 const CaminhoCompacto &melhor_global, int) {
+    for (int i=0; i<n_elite; i++) lab.depositar_feromonios(elite[i], config.intensidade_feromonio);
+
+    if (!melhor_global.empty()) {
+        lab.depositar_feromonios(melhor_global, config.intensidade_feromonio*config.elite*0.5);
+    }
+}
+
+// MMAS
+
+// número médio de escolhas em cada passo, usado no tau_min. No labirinto quase toda célula tem 1 ou 2 saídas
+// ainda não visitadas, então 2 é uma boa aproximação
+constexpr double MEDIA_ESCOLHAS_MMAS = 2.0;
+
+PoliticaMMAS::PoliticaMMAS(Labirinto &labirinto, const ConfigColonia &config)
+    :   lab(labirinto),
+        config(config),
+        tau_min(config.min_feromonio),
+        tau_max(std::numeric_limits<double>::max()) {}
+
+int PoliticaMMAS::n_depositantes() const {
+    return 1;
+}
+
+void PoliticaMMAS::evaporar() {
+    lab.evaporar_feromonios(config.taxa_evaporacao, tau_min);
+}
+
+void PoliticaMMAS::depositar(const std::vector<CaminhoCompacto> &elite, const int n_elite,
+                             const CaminhoCompacto &melhor_global, const int iteracao) {
+    if (melhor_global.empty()) return;
+
+    if (melhor_global.size() != tamanho_limites) {
+        tamanho_limites = melhor_global.size();
+        const double n = static_cast<double>(tamanho_limites);
+        tau_max = config.intensidade_feromonio / (config.taxa_evaporacao * n);
+        const double raiz = std::pow(config.mmas_p_melhor, 1.0 / n);
+        tau_min = std::max(tau_max * (1.0 - raiz) / ((MEDIA_ESCOLHAS_MMAS - 1.0) * raiz), config.min_feromonio);
+        tau_min = std::min(tau_min, tau_max);
+    }
+
+    const bool usar_global = n_elite == 0 || (config.mmas_intervalo_global > 0
+                                              && (iteracao + 1) % config.mmas_intervalo_global == 0);
+    lab.depositar_feromonios(usar_global ? melhor_global : elite[0], config.intensidade_feromonio, tau_max);
+}
+
+void PoliticaMMAS::salvar_estado(EscritorBinario &escritor) const {
+    escritor.valor(tau_min);
+    escritor.valor(tau_max);
+    escritor.valor(static_cast<std::uint64_t>(tamanho_limites));
+}
+
+void PoliticaMMAS::carregar_estado(LeitorBinario &leitor) {
+    tau_min = leitor.valor<double>();
+    tau_max = leitor.valor<double>();
+    tamanho_limites = leitor.valor<std::uint64_t>();
+}
+
+void PoliticaMMAS::reiniciar() {
+    tau_min = config.min_feromonio;
+    tau_max = std::numeric_limits<double>::max();
+    tamanho_limites = 0;
+}
+
+double PoliticaMMAS::get_tau_min() const {
+    return tau_min;
+}
+
+double PoliticaMMAS::get_tau_max() const {
+    return tau_max;
+}
+
+// ACS
+
+PoliticaACS::PoliticaACS(Labirinto &labirinto, const ConfigColonia &config)
+    :   lab(labirinto),
+        config(config) {}
+
+int PoliticaACS::n_depositantes() const {
+    return 1; // só para o melhor global ser atualizado, quem deposita é sempre o global
+}
+
+void PoliticaACS::evaporar() {
+    // no ACS a evaporação faz parte da atualização global (só no melhor caminho)
+}
+
+void PoliticaACS::depositar(const std::vector<CaminhoCompacto> &, int, const CaminhoCompacto &melhor_global, int) {
+    if (melhor_global.empty()) return;
+    const double alvo = config.intensidade_feromonio / static_cast<double>(melhor_global.size());
+    lab.misturar_feromonios(melhor_global, config.taxa_evaporacao, alvo);
+}
+
+void PoliticaACS::atualizacao_local(const CaminhoCompacto &caminho) {
+    lab.misturar_feromonios(caminho, config.acs_taxa_local, FEROMONIO_INICIAL);
+}
+
+// Rank
+
+PoliticaRank::PoliticaRank(Labirinto &labirinto, const ConfigColonia &config)
+    :   lab(labirinto),
+        config(config) {}
+
+int PoliticaRank::n_depositantes() const {
+    return std::max(config.elite - 1, 1);
+}
+
+void PoliticaRank::evaporar() {
+    lab.evaporar_feromonios(config.taxa_evaporacao, config.min_feromonio);
+}
+
+void PoliticaRank::depositar(const std::vector<CaminhoCompacto> &elite, const int n_elite,
+                             const CaminhoCompacto &melhor_global, int) {
+    const int w = std::max(config.elite, 2);
+    for (int i=0; i<n_elite; i++) {
+        lab.depositar_feromonios(elite[i], config.intensidade_feromonio * (w - 1 - i));
+    }
+    if (!melhor_global.empty()) lab.depositar_feromonios(melhor_global, config.intensidade_feromonio * w);
+}
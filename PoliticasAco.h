@@ -0,0 +1,130 @@
+#ifndef ACO_LABIRINTO_POLITICASACO_H
+#define ACO_LABIRINTO_POLITICASACO_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CaminhoCompacto.h"
+#include "Formiga.h"
+#include "Labirinto.h"
+#include "Serializacao.h"
+
+struct ConfigColonia; // Colonia.h
+
+// Variantes do ACO como políticas da ColoniaAco<Politica>. Tudo é resolvido em tempo de compilação: a Regra vira
+// o parâmetro do Formiga::andar<Regra> e as funções abaixo são chamadas direto, sem virtual.
+// Cada política precisa ter:
+//   using Regra                      regra de escolha do passo das formigas
+//   ATUALIZACAO_LOCAL                se true, a colônia chama atualizacao_local(caminho) para cada formiga depois
+//                                    da construção
+//   n_depositantes()                 quantas das melhores formigas a colônia passa para o depositar
+//   evaporar()
+//   depositar(elite, n, global, it)  elite[0..n) são os caminhos das melhores formigas em ordem crescente de
+//                                    tamanho (já encurtados, se estiver ligado), global é o melhor caminho até agora
+//   salvar_estado/carregar_estado    o que a política guarda entre iterações, para o checkpoint (Checkpoint.h)
+//   reiniciar()                      volta esse estado para o do construtor (ColoniaAco::reiniciar)
+//   ID_CHECKPOINT                    número da variante no checkpoint, diferente em cada política
+// As políticas guardam referências para o Labirinto e para o ConfigColonia da colônia
+
+// O esquema original: as ELITE melhores depositam intensidade/tamanho, o melhor global ganha mais 0.5*ELITE
+// depósitos, e o feromônio não cai abaixo de min_feromonio
+class PoliticaElitista {
+public:
+    using Regra = RegraProporcional;
+    static constexpr bool ATUALIZACAO_LOCAL = false;
+    static constexpr std::uint32_t ID_CHECKPOINT = 1;
+
+    PoliticaElitista(Labirinto& labirinto, const ConfigColonia& config);
+    [[nodiscard]] int n_depositantes() const;
+    void evaporar();
+    void depositar(const std::vector<CaminhoCompacto>& elite, int n_elite, const CaminhoCompacto& melhor_global,
+                   int iteracao);
+    void salvar_estado(EscritorBinario&) const {}
+    void carregar_estado(LeitorBinario&) {}
+    void reiniciar() {}
+
+private:
+    Labirinto& lab;
+    const ConfigColonia& config;
+};
+
+// Max-Min Ant System: só uma formiga deposita por iteração (a melhor da iteração, e a cada mmas_intervalo_global
+// iterações o melhor global), e o feromônio fica preso em [tau_min, tau_max]. Os limites são recalculados quando o
+// melhor global melhora: tau_max é o valor de equilíbrio de quem deposita todo turno no melhor caminho
+// (intensidade / (taxa_evaporacao * tamanho)), tau_min sai de tau_max e de mmas_p_melhor
+class PoliticaMMAS {
+public:
+    using Regra = RegraProporcional;
+    static constexpr bool ATUALIZACAO_LOCAL = false;
+    static constexpr std::uint32_t ID_CHECKPOINT = 2;
+
+    PoliticaMMAS(Labirinto& labirinto, const ConfigColonia& config);
+    [[nodiscard]] int n_depositantes() const;
+    void evaporar();
+    void depositar(const std::vector<CaminhoCompacto>& elite, int n_elite, const CaminhoCompacto& melhor_global,
+                   int iteracao);
+
+    void salvar_estado(EscritorBinario& escritor) const;
+    void carregar_estado(LeitorBinario& leitor);
+    void reiniciar();
+
+    [[nodiscard]] double get_tau_min() const;
+    [[nodiscard]] double get_tau_max() const;
+
+private:
+    Labirinto& lab;
+    const ConfigColonia& config;
+    double tau_min, tau_max;
+    size_t tamanho_limites = 0; // tamanho do melhor global usado no último cálculo dos limites
+};
+
+// Ant Colony System: regra pseudo-aleatória (acs_q0) e duas atualizações por mistura,
+// feromonio = (1-peso)*feromonio + peso*alvo. A global só mexe no melhor caminho (peso = taxa_evaporacao, alvo =
+// intensidade/tamanho), sem evaporação no resto do labirinto. A local puxa as células por onde as formigas passaram
+// de volta para FEROMONIO_INICIAL (peso = acs_taxa_local), para as próximas explorarem outros caminhos.
+// A local é aplicada depois da construção, na ordem das formigas, e não durante o passo como no ACS original:
+// assim as formigas continuam só lendo o labirinto em paralelo e o resultado não depende das threads
+class PoliticaACS {
+public:
+    using Regra = RegraPseudoAleatoria;
+    static constexpr bool ATUALIZACAO_LOCAL = true;
+    static constexpr std::uint32_t ID_CHECKPOINT = 3;
+
+    PoliticaACS(Labirinto& labirinto, const ConfigColonia& config);
+    [[nodiscard]] int n_depositantes() const;
+    void evaporar();
+    void depositar(const std::vector<CaminhoCompacto>& elite, int n_elite, const CaminhoCompacto& melhor_global,
+                   int iteracao);
+    void atualizacao_local(const CaminhoCompacto& caminho);
+    void salvar_estado(EscritorBinario&) const {}
+    void carregar_estado(LeitorBinario&) {}
+    void reiniciar() {}
+
+private:
+    Labirinto& lab;
+    const ConfigColonia& config;
+};
+
+// Rank-based AS: com w = ELITE, as w-1 melhores depositam com peso w-1, w-2, ..., 1 e o melhor global com peso w
+class PoliticaRank {
+public:
+    using Regra = RegraProporcional;
+    static constexpr bool ATUALIZACAO_LOCAL = false;
+    static constexpr std::uint32_t ID_CHECKPOINT = 4;
+
+    PoliticaRank(Labirinto& labirinto, const ConfigColonia& config);
+    [[nodiscard]] int n_depositantes() const;
+    void evaporar();
+    void depositar(const std::vector<CaminhoCompacto>& elite, int n_elite, const CaminhoCompacto& melhor_global,
+                   int iteracao);
+    void salvar_estado(EscritorBinario&) const {}
+    void carregar_estado(LeitorBinario&) {}
+    void reiniciar() {}
+
+private:
+    Labirinto& lab;
+    const ConfigColonia& config;
+};
+
+
+#endif //ACO_LABIRINTO_POLITICASACO_H
@@ -0,0 +1,72 @@
+#ifndef ACO_LABIRINTO_SERIALIZACAO_H
+#define ACO_LABIRINTO_SERIALIZACAO_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Leitura e escrita do estado em binário cru (a ordem de bytes da máquina, como os outros arquivos do projeto), para
+// o checkpoint (Checkpoint.h). Cada classe escreve e lê os próprios campos na mesma ordem; vetor vai como
+// uint64 tamanho + os elementos
+
+class EscritorBinario {
+public:
+    explicit EscritorBinario(std::vector<char>& destino) : destino(destino) {}
+
+    void bytes(const void* dados, const std::size_t n) {
+        const std::size_t inicio = destino.size();
+        destino.resize(inicio + n);
+        if (n > 0) std::memcpy(destino.data() + inicio, dados, n);
+    }
+    template<class T>
+    void valor(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes(&v, sizeof(T));
+    }
+    template<class T>
+    void vetor(const std::vector<T>& v) {
+        valor(static_cast<std::uint64_t>(v.size()));
+        bytes(v.data(), v.size() * sizeof(T));
+    }
+
+private:
+    std::vector<char>& destino;
+};
+
+// Arquivo truncado ou de outro formato dá runtime_error em vez de ler fora do buffer
+class LeitorBinario {
+public:
+    LeitorBinario(const char* inicio, const char* fim) : atual(inicio), fim(fim) {}
+
+    void bytes(void* dados, const std::size_t n) {
+        if (static_cast<std::size_t>(fim - atual) < n) throw std::runtime_error("Checkpoint truncado ou invalido!");
+        if (n > 0) std::memcpy(dados, atual, n);
+        atual += n;
+    }
+    template<class T>
+    [[nodiscard]] T valor() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T v;
+        bytes(&v, sizeof(T));
+        return v;
+    }
+    template<class T>
+    void vetor(std::vector<T>& v) {
+        const auto n = valor<std::uint64_t>();
+        if (n > static_cast<std::uint64_t>(fim - atual) / sizeof(T)) {
+            throw std::runtime_error("Checkpoint truncado ou invalido!");
+        }
+        v.resize(n);
+        bytes(v.data(), n * sizeof(T));
+    }
+    [[nodiscard]] bool terminou() const { return atual == fim; }
+
+private:
+    const char* atual;
+    const char* fim;
+};
+
+
+#endif //ACO_LABIRINTO_SERIALIZACAO_H
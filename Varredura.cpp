@@ -0,0 +1,102 @@
+#include "Varredura.h"
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+
+#include "Colonia.h"
+#include "ColoniaGrafo.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template<class ColoniaT>
+static ResultadoVarredura rodar(Labirinto& lab, const ConfigExecucao& config) {
+    ColoniaT colonia(lab, config.colonia);
+    ResultadoVarredura resultado;
+    int estagnacao = 0;
+    while (resultado.iteracoes < config.n_iteracoes) { // mesma parada do loop do main
+        const ResultadoIteracao iteracao = colonia.iterar();
+        resultado.iteracoes++;
+        if (iteracao.melhorou_global) {
+            estagnacao = 0;
+            resultado.iteracao_melhor = resultado.iteracoes;
+        }
+        else estagnacao++;
+        if (config.parada_por_estagnacao != -1 && estagnacao >= config.parada_por_estagnacao) break;
+    }
+    resultado.melhor = colonia.get_menor_tamanho_global();
+    return resultado;
+}
+
+ResultadoVarredura executar_configuracao(Labirinto &lab, const ConfigExecucao &config) {
+    if (config.ilhas.n_ilhas > 1) throw std::runtime_error("A varredura nao roda o modelo de ilhas (n_ilhas > 1)");
+
+    const auto inicio = std::chrono::steady_clock::now();
+    ResultadoVarredura resultado;
+    if (config.usar_grafo_juncoes) resultado = rodar<ColoniaGrafo>(lab, config);
+    else {
+        switch (config.variante) {
+            case VarianteAco::ELITISTA: resultado = rodar<Colonia>(lab, config); break;
+            case VarianteAco::MMAS: resultado = rodar<ColoniaMMAS>(lab, config); break;
+            case VarianteAco::ACS: resultado = rodar<ColoniaACS>(lab, config); break;
+            case VarianteAco::RANK: resultado = rodar<ColoniaRank>(lab, config); break;
+        }
+    }
+    resultado.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+void executar_varredura(const Labirinto &base, const GradeVarredura &grade, std::ostream &saida) {
+    const int n = static_cast<int>(grade.configs.size());
+    for (const ConfigExecucao& config : grade.configs) {
+        if (config.ilhas.n_ilhas > 1) throw std::runtime_error("A varredura nao roda o modelo de ilhas (n_ilhas > 1)");
+    }
+
+    // uma cópia da base por beta diferente, com a tabela da heurística pronta. As cópias de cada configuração saem
+    // daqui e herdam a tabela (o preparar_heuristica do construtor da colônia vê que já está pronta)
+    std::map<double, Labirinto> bases;
+    for (const ConfigExecucao& config : grade.configs) {
+        if (bases.contains(config.colonia.beta)) continue;
+        Labirinto& copia = bases.emplace(config.colonia.beta, base).first->second;
+        copia.preparar_heuristica(config.colonia.beta);
+    }
+
+    saida << "indice";
+    for (const std::string& chave : grade.chaves) saida << ',' << chave;
+    saida << ",melhor,iteracao_melhor,iteracoes,segundos" << std::endl;
+
+    std::exception_ptr erro;
+    int terminadas = 0;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i=0; i<n; i++) {
+#ifdef _OPENMP
+        omp_set_num_threads(1); // vale só para esta thread: a colônia não abre outro time dentro da varredura
+#endif
+        const ConfigExecucao& config = grade.configs[i];
+        try {
+            Labirinto lab = bases.at(config.colonia.beta);
+            lab.set_modo_evaporacao(config.evaporacao_preguicosa ? ModoEvaporacao::PREGUICOSA
+                                                                 : ModoEvaporacao::IMEDIATA);
+            const ResultadoVarredura resultado = executar_configuracao(lab, config);
+
+            #pragma omp critical(aco_varredura_saida)
+            {
+                saida << i;
+                for (const std::string& valor : grade.valores[i]) saida << ',' << valor;
+                saida << ',' << resultado.melhor << ',' << resultado.iteracao_melhor << ','
+                      << resultado.iteracoes << ',' << resultado.segundos << std::endl;
+                terminadas++;
+                std::cout << "CONFIGURACAO " << i << " (" << terminadas << '/' << n << "): melhor "
+                          << resultado.melhor << " em " << resultado.iteracoes << " iteracoes\n";
+            }
+        } catch (...) {
+            // exceção não pode sair do bloco paralelo, guarda a primeira e joga depois
+            #pragma omp critical(aco_varredura_erro)
+            if (!erro) erro = std::current_exception();
+        }
+    }
+    if (erro) std::rethrow_exception(erro);
+}
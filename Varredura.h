@@ -0,0 +1,28 @@
+#ifndef ACO_LABIRINTO_VARREDURA_H
+#define ACO_LABIRINTO_VARREDURA_H
+
+#include <iosfwd>
+
+#include "Configuracao.h"
+#include "Labirinto.h"
+
+struct ResultadoVarredura {
+    int melhor = -1; // -1 = nenhuma formiga achou a comida
+    int iteracao_melhor = -1; // em que iteração o melhor apareceu (começando do 1)
+    int iteracoes = 0; // feitas de verdade (a estagnação pode parar antes do n_iteracoes)
+    double segundos = 0.0;
+};
+
+// Roda uma configuração até o n_iteracoes ou a estagnação, sem imprimir nem salvar nada.
+// lab é usado como está (feromônio inicial, modo de evaporação...), quem chama faz a cópia
+[[nodiscard]] ResultadoVarredura executar_configuracao(Labirinto& lab, const ConfigExecucao& config);
+
+// Roda todas as configurações da grade em cima do labirinto base, várias ao mesmo tempo (uma por thread do OpenMP,
+// cada uma com 1 thread só). Cada configuração tem a sua cópia do Labirinto: as paredes são as da base e a tabela
+// da heurística é montada uma vez por beta e compartilhada, só o feromônio é de cada uma.
+// Escreve o resumo em CSV (indice, as chaves da grade, melhor, iteracao_melhor, iteracoes, segundos), uma linha
+// por configuração na ordem em que terminam. O resultado de cada uma não depende de quantas rodam juntas
+void executar_varredura(const Labirinto& base, const GradeVarredura& grade, std::ostream& saida);
+
+
+#endif //ACO_LABIRINTO_VARREDURA_H
@@ -0,0 +1,209 @@
+#include "Visualizacao.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+void salvar_iteracao(const Labirinto& lab, const std::string& arquivo) {
+    std::ofstream arq_out(arquivo);
+    if (!arq_out.is_open()) {
+        std::cerr << "ERRO! Nao foi possivel criar o arquivo " << arquivo << std::endl;
+        return;
+    }
+
+    for (int i=0; i<lab.get_largura(); i++) {
+        for (int j=0; j<lab.get_altura(); j++) {
+            Pos p = {i, j};
+
+            switch (lab.get_valor_grid(p)) {
+                case 1:
+                    arq_out << -1;
+                    break;
+
+                case 2:
+                    arq_out << -2;
+                    break;
+
+                case 3:
+                    arq_out << -3;
+                    break;
+
+                default:
+                    arq_out << lab.get_feromonio(p);
+                    break;
+            }
+            if (j < lab.get_altura()-1) arq_out << ',';
+        }
+        arq_out << '\n';
+    }
+}
+
+// Abre um snapshots.bin de uma execução interrompida para continuar escrevendo nele. O começo do arquivo (cabeçalho,
+// extensão e camada fixa) tem que ser igual ao que esta execução escreveria. Os quadros a partir de
+// continuar_da_iteracao (os que a execução interrompida escreveu depois do checkpoint) são cortados
+static bool continuar_arquivo(const std::string& caminho, const std::vector<char>& inicio, const size_t tamanho_quadro,
+                              const int continuar_da_iteracao) {
+    std::ifstream existente(caminho, std::ios::binary);
+    if (!existente.is_open()) return false; // não tem, começa um novo
+
+    std::vector<char> inicio_existente(inicio.size());
+    existente.read(inicio_existente.data(), static_cast<std::streamsize>(inicio_existente.size()));
+    if (!existente || inicio_existente != inicio) {
+        throw std::runtime_error(caminho + " e de outra execucao (ou de outro nivel/regiao), nao da pra continuar nele."
+                                 " Apague ou mova o arquivo antes de retomar");
+    }
+
+    // quadros completos com iteração anterior à retomada (estão em ordem crescente)
+    const std::uint64_t tamanho = std::filesystem::file_size(caminho);
+    const std::uint64_t n_quadros = (tamanho - inicio.size()) / tamanho_quadro;
+    std::uint64_t manter = 0;
+    while (manter < n_quadros) {
+        std::int32_t iteracao;
+        existente.seekg(static_cast<std::streamoff>(inicio.size() + manter * tamanho_quadro));
+        existente.read(reinterpret_cast<char*>(&iteracao), sizeof(iteracao));
+        if (!existente || iteracao >= continuar_da_iteracao) break;
+        manter++;
+    }
+    existente.close();
+    std::filesystem::resize_file(caminho, inicio.size() + manter * tamanho_quadro);
+    return true;
+}
+
+GravadorSnapshots::GravadorSnapshots(const std::string &caminho, const Labirinto &lab, const int nivel,
+                                     const RegiaoPiramide &regiao, const int continuar_da_iteracao)
+    :   piramide(nivel > 0 || regiao.largura > 0 || regiao.altura > 0),
+        nivel(nivel)
+{
+    // confere antes de abrir, para um parâmetro errado não apagar os snapshots da execução anterior
+    if (nivel < 0 || nivel >= lab.get_niveis_piramide()) {
+        throw std::runtime_error("O labirinto so tem " + std::to_string(lab.get_niveis_piramide())
+                                 + " niveis de piramide (0 a " + std::to_string(lab.get_niveis_piramide() - 1) + ")");
+    }
+    blocos = regiao_no_nivel(regiao, nivel, lab.get_largura(), lab.get_altura());
+
+    const size_t n_blocos = static_cast<size_t>(blocos.largura) * blocos.altura;
+    n_valores = piramide ? 2 * n_blocos : n_blocos;
+    const size_t inicio_camada = sizeof(CabecalhoSnapshot) + (piramide ? sizeof(ExtensaoSnapshot) : 0);
+
+    CabecalhoSnapshot cabecalho{};
+    std::copy(std::begin(MAGICO_SNAPSHOT), std::end(MAGICO_SNAPSHOT), cabecalho.magico);
+    cabecalho.versao = piramide ? VERSAO_SNAPSHOT_PIRAMIDE : VERSAO_SNAPSHOT;
+    cabecalho.largura = blocos.largura;
+    cabecalho.altura = blocos.altura;
+    cabecalho.tipo_valor = piramide ? 1 : 0;
+    cabecalho.offset_quadros = (inicio_camada + n_blocos + 7) / 8 * 8;
+    cabecalho.tamanho_quadro = 2 * sizeof(std::uint32_t) + n_valores * sizeof(float);
+    cabecalho.ninho_x = lab.get_pos_ninho().x;
+    cabecalho.ninho_y = lab.get_pos_ninho().y;
+    cabecalho.comida_x = lab.get_pos_comida().x;
+    cabecalho.comida_y = lab.get_pos_comida().y;
+
+    // tudo antes dos quadros: cabeçalho, extensão (v2) e a camada fixa, montados aqui para comparar com o arquivo
+    // que já existe quando for continuar
+    std::vector<char> inicio(cabecalho.offset_quadros, 0);
+    std::memcpy(inicio.data(), &cabecalho, sizeof(cabecalho));
+    if (piramide) {
+        const ExtensaoSnapshot extensao{static_cast<std::uint32_t>(nivel), static_cast<std::uint32_t>(blocos.x),
+                                        static_cast<std::uint32_t>(blocos.y), 0};
+        std::memcpy(inicio.data() + sizeof(cabecalho), &extensao, sizeof(extensao));
+    }
+
+    // camada fixa, as paredes não mudam durante a execução. No bloco vale o ninho, depois a comida, depois o chão
+    char* camada = inicio.data() + inicio_camada;
+    if (piramide) std::fill_n(camada, n_blocos, 1);
+    const int lado = 1 << nivel;
+    for (int i=blocos.x*lado; i<std::min((blocos.x + blocos.largura)*lado, lab.get_largura()); i++) {
+        for (int j=blocos.y*lado; j<std::min((blocos.y + blocos.altura)*lado, lab.get_altura()); j++) {
+            const Pos p = {i, j};
+            char& bloco = camada[(i/lado - blocos.x) * blocos.altura + j/lado - blocos.y];
+            const int valor = lab.valor_grid_rapido(p);
+            if (!piramide) bloco = static_cast<char>(valor);
+            else if (valor == 3 || (valor == 2 && bloco != 3) || (valor == 0 && bloco == 1)) {
+                bloco = static_cast<char>(valor);
+            }
+        }
+    }
+
+    if (continuar_da_iteracao >= 0
+        && continuar_arquivo(caminho, inicio, cabecalho.tamanho_quadro, continuar_da_iteracao)) {
+        arquivo.open(caminho, std::ios::binary | std::ios::app);
+    }
+    else {
+        arquivo.open(caminho, std::ios::binary);
+        arquivo.write(inicio.data(), static_cast<std::streamsize>(inicio.size()));
+    }
+    if (!arquivo.is_open()) {
+        std::cerr << "ERRO! Nao foi possivel criar o arquivo " << caminho << std::endl;
+        return;
+    }
+
+    for (std::vector<float>& buffer : buffers) buffer.resize(n_valores);
+    escritor = std::thread(&GravadorSnapshots::loop_escritor, this);
+}
+
+GravadorSnapshots::~GravadorSnapshots() {
+    if (!escritor.joinable()) return;
+    {
+        std::lock_guard trava(mutex);
+        parar = true;
+    }
+    condicao.notify_all();
+    escritor.join();
+}
+
+void GravadorSnapshots::enviar(const Labirinto &lab, const int iteracao) {
+    if (!escritor.joinable()) return;
+
+    // a cópia pode acontecer enquanto a thread escreve o outro buffer
+    {
+        std::unique_lock trava(mutex);
+        condicao.wait(trava, [this] { return buffer_escrevendo != buffer_livre && buffer_pendente != buffer_livre; });
+    }
+
+    if (!piramide) lab.copiar_feromonios(buffers[buffer_livre].data());
+    else {
+        float* buffer = buffers[buffer_livre].data();
+        lab.exportar_piramide(nivel, blocos, buffer, buffer + n_valores / 2);
+    }
+    iteracao_buffer[buffer_livre] = iteracao;
+
+    {
+        std::unique_lock trava(mutex);
+        condicao.wait(trava, [this] { return buffer_pendente == -1; });
+        buffer_pendente = buffer_livre;
+        buffer_livre ^= 1;
+    }
+    condicao.notify_all();
+}
+
+void GravadorSnapshots::loop_escritor() {
+    while (true) {
+        int indice;
+        {
+            std::unique_lock trava(mutex);
+            condicao.wait(trava, [this] { return buffer_pendente != -1 || parar; });
+            if (buffer_pendente == -1) break; // parar e nada na fila
+            indice = buffer_pendente;
+            buffer_escrevendo = indice;
+            buffer_pendente = -1;
+        }
+        condicao.notify_all();
+
+        const std::int32_t iteracao = iteracao_buffer[indice];
+        const std::uint32_t reservado = 0;
+        arquivo.write(reinterpret_cast<const char*>(&iteracao), sizeof(iteracao));
+        arquivo.write(reinterpret_cast<const char*>(&reservado), sizeof(reservado));
+        arquivo.write(reinterpret_cast<const char*>(buffers[indice].data()),
+                      static_cast<std::streamsize>(n_valores * sizeof(float)));
+        arquivo.flush(); // quadro inteiro no disco, o main.py pode abrir com a execução ainda rodando
+
+        {
+            std::lock_guard trava(mutex);
+            buffer_escrevendo = -1;
+        }
+        condicao.notify_all();
+    }
+}
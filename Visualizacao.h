@@ -0,0 +1,90 @@
+#ifndef ACO_LABIRINTO_VISUALIZACAO_H
+#define ACO_LABIRINTO_VISUALIZACAO_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Labirinto.h"
+
+// Salva o labirinto em CSV: paredes = -1, comida = -2, ninho = -3, o resto é o feromônio da célula.
+// Formato antigo do main.py, ficou para comparação no ACO_Benchmark
+void salvar_iteracao(const Labirinto& lab, const std::string& arquivo);
+
+// Formato binário dos snapshots (little-endian), lido pelo main.py com numpy.memmap:
+//   CabecalhoSnapshot (64 bytes)
+//   camada fixa: largura*altura bytes com o grid (0 = chão, 1 = parede, 2 = comida, 3 = ninho), escrita uma vez só
+//   zeros até offset_quadros (múltiplo de 8)
+//   quadros de tamanho_quadro bytes: int32 iteração, uint32 reservado, float32 feromônio[largura*altura]
+// A ordem das células é a mesma do Labirinto (x*altura + y)
+// Versão 2, para labirinto grande (um nível da pirâmide e/ou uma região, PiramideFeromonio.h):
+//   CabecalhoSnapshot com largura/altura da região em blocos do nível e tipo_valor = 1, seguido da ExtensaoSnapshot
+//   camada fixa: 1 byte por bloco (3 = tem o ninho, 2 = tem a comida, 0 = tem chão, 1 = só parede)
+//   quadros: int32 iteração, uint32 reservado, float32 máximo[n_blocos], float32 média[n_blocos]
+// Sem nível e sem região continua saindo a versão 1
+constexpr char MAGICO_SNAPSHOT[8] = {'A', 'C', 'O', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t VERSAO_SNAPSHOT = 1;
+constexpr std::uint32_t VERSAO_SNAPSHOT_PIRAMIDE = 2;
+
+struct CabecalhoSnapshot {
+    char magico[8];
+    std::uint32_t versao;
+    std::uint32_t largura, altura;
+    std::uint32_t tipo_valor; // 0 = um float32 por célula (v1), 1 = float32 máximo e float32 média por bloco (v2)
+    std::uint64_t offset_quadros;
+    std::uint64_t tamanho_quadro;
+    std::int32_t ninho_x, ninho_y, comida_x, comida_y;
+    std::uint8_t reservado[8];
+};
+static_assert(sizeof(CabecalhoSnapshot) == 64);
+
+struct ExtensaoSnapshot {
+    std::uint32_t nivel; // blocos de 2^nivel x 2^nivel células
+    std::uint32_t regiao_x, regiao_y; // canto da região, em blocos do nível
+    std::uint32_t reservado;
+};
+static_assert(sizeof(ExtensaoSnapshot) == 16);
+
+// Junta os snapshots num arquivo só, escrito por uma thread separada. enviar() só copia o feromônio para um dos
+// dois buffers e volta pra colônia; enquanto a thread escreve um buffer, o próximo snapshot já pode ser copiado
+// no outro. Só espera se os dois estiverem ocupados (disco mais lento que SALVAR_ITERACAO iterações).
+// Com nivel > 0 ou uma região (em células) sai a versão 2, e cada snapshot custa o tamanho da região no nível.
+// continuar_da_iteracao >= 0 (retomada de um checkpoint): se o arquivo já existir ele continua no final, sem os
+// quadros dessa iteração em diante. Arquivo de outra execução dá runtime_error em vez de ser apagado
+class GravadorSnapshots {
+public:
+    GravadorSnapshots(const std::string& caminho, const Labirinto& lab, int nivel = 0,
+                      const RegiaoPiramide& regiao = {}, int continuar_da_iteracao = -1);
+    ~GravadorSnapshots(); // escreve o que falta e fecha o arquivo
+    GravadorSnapshots(const GravadorSnapshots&) = delete;
+    GravadorSnapshots& operator=(const GravadorSnapshots&) = delete;
+
+    void enviar(const Labirinto& lab, int iteracao);
+
+private:
+    std::ofstream arquivo;
+    bool piramide = false; // versão 2
+    int nivel = 0;
+    RegiaoPiramide blocos; // a região em blocos do nível
+    size_t n_valores = 0; // floats por quadro
+
+    std::array<std::vector<float>, 2> buffers;
+    std::array<int, 2> iteracao_buffer{};
+    int buffer_livre = 0; // o que a colônia preenche na próxima vez
+    int buffer_pendente = -1; // na fila da thread (-1 = nenhum)
+    int buffer_escrevendo = -1; // a thread está escrevendo agora (-1 = nenhum)
+    bool parar = false;
+    std::mutex mutex;
+    std::condition_variable condicao;
+    std::thread escritor; // por último, só começa depois de tudo acima existir
+
+    void loop_escritor();
+};
+
+
+#endif //ACO_LABIRINTO_VISUALIZACAO_H
@@ -0,0 +1,15 @@
+#ifndef ACO_LABIRINTO_CRONOMETRAGEM_H
+#define ACO_LABIRINTO_CRONOMETRAGEM_H
+
+#include <chrono>
+
+// Segundos que f() leva. Fica aqui e não no Cronometro (Metricas.h) porque os benchmarks medem mesmo compilados
+// com ACO_METRICAS=0, quando o Cronometro não faz nada
+template<class F>
+inline double cronometrar(F&& f) {
+    const auto inicio = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+#endif //ACO_LABIRINTO_CRONOMETRAGEM_H
@@ -0,0 +1,67 @@
+// Gerar o labirinto contra abrir o mesmo labirinto salvo (ArquivoLabirinto.h). Gera um PILARES_DIFICIL, salva,
+// abre de novo e confere que as paredes, o ninho e a comida são os mesmos.
+// mapear é só o mmap das paredes; carregar é o Labirinto inteiro, que ainda aloca o feromônio (8 bytes por célula),
+// então em labirinto grande a diferença entre os dois é o feromônio
+// Uso: ACO_ArquivoLabirinto [largura] [arquivo]
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../ArquivoLabirinto.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+#include "Cronometragem.h"
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 5001;
+    const std::string arquivo = argc > 2 ? argv[2] : "aco_benchmark_labirinto.lab";
+
+    try {
+        ConfigLabirinto config_labirinto;
+        config_labirinto.algoritmo = AlgoritmoLabirinto::PILARES_DIFICIL;
+        config_labirinto.semente = 1;
+
+        std::unique_ptr<Labirinto> gerado;
+        const double t_gerar = cronometrar([&] {
+            gerado = std::make_unique<Labirinto>(largura, largura, config_labirinto);
+        });
+        const double t_salvar = cronometrar([&] { gerado->salvar(arquivo); });
+
+        ArquivoLabirinto mapeado;
+        const double t_mapear = cronometrar([&] { mapeado = mapear_arquivo_labirinto(arquivo); });
+
+        // confere direto nas palavras mapeadas, assim só um Labirinto (com o feromônio) existe por vez
+        bool iguais = mapeado.largura == gerado->get_largura() && mapeado.altura == gerado->get_altura()
+                      && mapeado.pos_ninho == gerado->get_pos_ninho()
+                      && mapeado.pos_comida == gerado->get_pos_comida();
+        for (int i=0; i<largura && iguais; i++) {
+            for (int j=0; j<largura; j++) {
+                const int c = gerado->indice({i, j});
+                const bool parede = (mapeado.paredes.get()[c / 64] >> (c % 64)) & 1;
+                if (parede != gerado->parede_rapida({i, j})) {
+                    iguais = false;
+                    break;
+                }
+            }
+        }
+        mapeado = {};
+        gerado.reset();
+
+        std::unique_ptr<Labirinto> carregado;
+        const double t_carregar = cronometrar([&] { carregado = std::make_unique<Labirinto>(arquivo); });
+
+        const double megabytes = (sizeof(CabecalhoLabirinto)
+                                  + (static_cast<double>(largura) * largura + 63) / 64 * 8) / (1024.0 * 1024.0);
+        std::cout << "largura,gerar_s,salvar_s,mapear_s,carregar_s,arquivo_mb,iguais\n"
+                  << largura << ',' << t_gerar << ',' << t_salvar << ',' << t_mapear << ',' << t_carregar << ','
+                  << megabytes << ',' << (iguais ? "sim" : "nao") << std::endl;
+        std::remove(arquivo.c_str());
+        return iguais ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        std::remove(arquivo.c_str());
+        return 1;
+    }
+}
@@ -0,0 +1,230 @@
+// Benchmark das fases do ACO, para pegar regressão de desempenho entre versões.
+// Varre tamanhos de labirinto, número de formigas e LABIRINTO_DIFICIL ligado/desligado, sempre com sementes fixas,
+// e mede cada fase isolada (construção, evaporação, ordenação da elite, depósito, salvar_iteracao em CSV,
+// snapshot binário) e a iteração completa de ponta a ponta. snapshot_binario é o tempo que a colônia fica parada
+// no GravadorSnapshots::enviar (a escrita em si fica na thread dele). A saída é CSV (padrão) ou JSON lines.
+//
+// Uso: ACO_Benchmark [--tamanhos=150,500,1000,2000,4000] [--formigas=50,100] [--dificil=0,1] [--iteracoes=5]
+//                    [--evaporacao=preguicosa|imediata] [--poda=desligada|entre_iteracoes|imediata]
+//                    [--variante=elitista|mmas|acs|rank] [--motor=escalar|lote|lote_sem_simd]
+//                    [--formato=csv|json] [--saida=arquivo]
+//
+// pico_rss_kb é o pico de memória do processo até aquela linha (não é zerado entre configurações), então rodar
+// os tamanhos em ordem crescente deixa o número de cada tamanho fácil de ler
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Colonia.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+#include "../Visualizacao.h"
+#include "Cronometragem.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+constexpr std::uint64_t SEMENTE_LABIRINTO = 1;
+constexpr std::uint64_t SEMENTE_FORMIGAS = 42;
+
+struct Opcoes {
+    std::vector<int> tamanhos = {150, 500, 1000, 2000, 4000};
+    std::vector<int> formigas = {50, 100};
+    std::vector<int> dificil = {0, 1};
+    int iteracoes = 5;
+    bool evaporacao_preguicosa = true;
+    ModoPoda poda = ModoPoda::DESLIGADA;
+    std::string variante = "elitista";
+    MotorFormigas motor = MotorFormigas::ESCALAR;
+    bool json = false;
+    std::string saida;
+};
+
+struct Linha {
+    int tamanho, formigas;
+    bool dificil;
+    std::string fase;
+    int repeticoes;
+    double segundos;
+    long long passos; // só na construção e ponta a ponta
+};
+
+static std::vector<int> ler_lista(const std::string& texto) {
+    std::vector<int> valores;
+    std::stringstream ss(texto);
+    std::string item;
+    while (std::getline(ss, item, ',')) valores.push_back(std::stoi(item));
+    return valores;
+}
+
+static Opcoes ler_opcoes(const int argc, char* argv[]) {
+    Opcoes opcoes;
+    for (int i=1; i<argc; i++) {
+        const std::string arg = argv[i];
+        const size_t igual = arg.find('=');
+        const std::string chave = arg.substr(0, igual);
+        const std::string valor = igual == std::string::npos ? "" : arg.substr(igual + 1);
+
+        if (chave == "--tamanhos") opcoes.tamanhos = ler_lista(valor);
+        else if (chave == "--formigas") opcoes.formigas = ler_lista(valor);
+        else if (chave == "--dificil") opcoes.dificil = ler_lista(valor);
+        else if (chave == "--iteracoes") opcoes.iteracoes = std::stoi(valor);
+        else if (chave == "--evaporacao") opcoes.evaporacao_preguicosa = valor != "imediata";
+        else if (chave == "--poda") {
+            if (valor == "desligada") opcoes.poda = ModoPoda::DESLIGADA;
+            else if (valor == "entre_iteracoes") opcoes.poda = ModoPoda::ENTRE_ITERACOES;
+            else if (valor == "imediata") opcoes.poda = ModoPoda::IMEDIATA;
+            else throw std::runtime_error("Poda desconhecida: " + valor);
+        }
+        else if (chave == "--variante") {
+            if (valor != "elitista" && valor != "mmas" && valor != "acs" && valor != "rank") {
+                throw std::runtime_error("Variante desconhecida: " + valor);
+            }
+            opcoes.variante = valor;
+        }
+        else if (chave == "--motor") {
+            if (valor == "escalar") opcoes.motor = MotorFormigas::ESCALAR;
+            else if (valor == "lote") opcoes.motor = MotorFormigas::LOTE;
+            else if (valor == "lote_sem_simd") opcoes.motor = MotorFormigas::LOTE_SEM_SIMD;
+            else throw std::runtime_error("Motor desconhecido: " + valor);
+        }
+        else if (chave == "--formato") opcoes.json = valor == "json";
+        else if (chave == "--saida") opcoes.saida = valor;
+        else throw std::runtime_error("Opcao desconhecida: " + arg);
+    }
+    return opcoes;
+}
+
+static long pico_rss_kb() {
+#ifndef _WIN32
+    rusage uso{};
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss; // em KB no Linux
+#else
+    return 0;
+#endif
+}
+
+static void escrever(std::ostream& out, const Linha& l, const bool json) {
+    const double passos_por_s = l.passos > 0 ? l.passos / l.segundos : 0.0;
+    const double iteracoes_por_s = l.repeticoes / l.segundos;
+    if (json) {
+        out << "{\"tamanho\":" << l.tamanho << ",\"formigas\":" << l.formigas
+            << ",\"dificil\":" << (l.dificil ? "true" : "false") << ",\"fase\":\"" << l.fase << '"'
+            << ",\"repeticoes\":" << l.repeticoes << ",\"segundos\":" << l.segundos << ",\"passos\":" << l.passos
+            << ",\"passos_por_s\":" << passos_por_s << ",\"iteracoes_por_s\":" << iteracoes_por_s
+            << ",\"pico_rss_kb\":" << pico_rss_kb() << "}\n";
+    }
+    else {
+        out << l.tamanho << ',' << l.formigas << ',' << l.dificil << ',' << l.fase << ',' << l.repeticoes << ','
+            << l.segundos << ',' << l.passos << ',' << passos_por_s << ',' << iteracoes_por_s << ','
+            << pico_rss_kb() << '\n';
+    }
+    out.flush();
+}
+
+const std::string ARQUIVO_SNAPSHOT = "aco_benchmark_snapshot.csv";
+const std::string ARQUIVO_BINARIO = "aco_benchmark_snapshot.bin";
+
+// Mede uma configuração (tamanho, formigas, difícil) com a variante ColoniaT
+template<class ColoniaT>
+static void medir(std::ostream& out, const Opcoes& opcoes, const Labirinto& base, const ConfigColonia& config,
+                  const bool d) {
+    const int tamanho = base.get_largura();
+    const int n_formigas = config.n_formigas;
+
+    // 1) fases isoladas, na ordem de uma iteração normal
+    {
+        Labirinto lab = base;
+        ColoniaT colonia(lab, config);
+        double t_construcao = 0, t_evaporacao = 0, t_ordenacao = 0, t_deposito = 0, t_snapshot = 0;
+        double t_binario = 0;
+        GravadorSnapshots snapshots(ARQUIVO_BINARIO, lab);
+        long long passos = 0;
+
+        for (int it=0; it<opcoes.iteracoes; it++) {
+            ResultadoIteracao resultado;
+            t_construcao += cronometrar([&] { colonia.construir_solucoes(); });
+            passos += colonia.get_passos_ultima_iteracao();
+            t_evaporacao += cronometrar([&] { colonia.evaporar(); });
+            t_ordenacao += cronometrar([&] { colonia.selecionar_elite(resultado); });
+            t_deposito += cronometrar([&] { colonia.depositar_elite(resultado); });
+            t_snapshot += cronometrar([&] { salvar_iteracao(lab, ARQUIVO_SNAPSHOT); });
+            t_binario += cronometrar([&] { snapshots.enviar(lab, it); });
+        }
+
+        const int n = opcoes.iteracoes;
+        escrever(out, {tamanho, n_formigas, d, "construcao", n, t_construcao, passos}, opcoes.json);
+        escrever(out, {tamanho, n_formigas, d, "evaporacao", n, t_evaporacao, 0}, opcoes.json);
+        escrever(out, {tamanho, n_formigas, d, "ordenacao_elite", n, t_ordenacao, 0}, opcoes.json);
+        escrever(out, {tamanho, n_formigas, d, "deposito", n, t_deposito, 0}, opcoes.json);
+        escrever(out, {tamanho, n_formigas, d, "salvar_iteracao", n, t_snapshot, 0}, opcoes.json);
+        escrever(out, {tamanho, n_formigas, d, "snapshot_binario", n, t_binario, 0}, opcoes.json);
+    }
+
+    // 2) ponta a ponta, começando do mesmo labirinto
+    {
+        Labirinto lab = base;
+        ColoniaT colonia(lab, config);
+        long long passos = 0;
+        const double segundos = cronometrar([&] {
+            for (int it=0; it<opcoes.iteracoes; it++) {
+                colonia.iterar();
+                passos += colonia.get_passos_ultima_iteracao();
+            }
+        });
+        escrever(out, {tamanho, n_formigas, d, "ponta_a_ponta", opcoes.iteracoes, segundos, passos}, opcoes.json);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    Opcoes opcoes;
+    try {
+        opcoes = ler_opcoes(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream arquivo;
+    if (!opcoes.saida.empty()) arquivo.open(opcoes.saida);
+    std::ostream& out = opcoes.saida.empty() ? std::cout : arquivo;
+
+    if (!opcoes.json) {
+        out << "tamanho,formigas,dificil,fase,repeticoes,segundos,passos,passos_por_s,iteracoes_por_s,pico_rss_kb\n";
+    }
+
+    for (const int tamanho : opcoes.tamanhos) {
+        for (const int dificil : opcoes.dificil) {
+            ConfigLabirinto config_labirinto;
+            config_labirinto.algoritmo = dificil ? AlgoritmoLabirinto::PILARES_DIFICIL : AlgoritmoLabirinto::PILARES;
+            config_labirinto.semente = SEMENTE_LABIRINTO;
+
+            Labirinto base(tamanho, tamanho, config_labirinto);
+            if (opcoes.evaporacao_preguicosa) base.set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+
+            for (const int n_formigas : opcoes.formigas) {
+                ConfigColonia config;
+                config.n_formigas = n_formigas;
+                config.intensidade_feromonio = tamanho * tamanho * 0.1;
+                config.semente = SEMENTE_FORMIGAS;
+                config.poda = opcoes.poda;
+                config.motor = opcoes.motor;
+
+                if (opcoes.variante == "mmas") medir<ColoniaMMAS>(out, opcoes, base, config, dificil != 0);
+                else if (opcoes.variante == "acs") medir<ColoniaACS>(out, opcoes, base, config, dificil != 0);
+                else if (opcoes.variante == "rank") medir<ColoniaRank>(out, opcoes, base, config, dificil != 0);
+                else medir<Colonia>(out, opcoes, base, config, dificil != 0);
+            }
+        }
+    }
+
+    std::remove(ARQUIVO_SNAPSHOT.c_str());
+    std::remove(ARQUIVO_BINARIO.c_str());
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Checkpoint e retomada (Checkpoint.h). Para cada variante roda n iterações direto e, separado, roda até o corte,
+// salva o checkpoint, joga fora o labirinto e a colônia, cria os dois de novo, carrega e termina as iterações.
+// "iguais" compara o estado inteiro no final (feromônio bit a bit, evaporação, melhor caminho, política) das duas
+// execuções. O custo do checkpoint (enviar na thread da colônia + escrita + carregar) é comparado com o tempo das
+// iterações até o corte, que seria o que se perde sem ele
+// Uso: ACO_Checkpoint [largura] [iteracoes] [corte] [formigas] [arquivo]
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Checkpoint.h"
+#include "../Colonia.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+#include "../Serializacao.h"
+#include "Cronometragem.h"
+
+// FNV-1a do estado serializado do labirinto e da colônia
+template<class ColoniaT>
+static std::uint64_t assinatura(const Labirinto& lab, const ColoniaT& colonia) {
+    std::vector<char> estado;
+    EscritorBinario escritor(estado);
+    lab.salvar_estado(escritor);
+    colonia.salvar_estado(escritor);
+    std::uint64_t h = 1469598103934665603ull;
+    for (const char c : estado) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+template<class ColoniaT>
+static bool medir(const char* nome, const int largura, const int iteracoes, const int corte,
+                  const ConfigColonia& config, const std::string& arquivo) {
+    ConfigLabirinto config_labirinto;
+    config_labirinto.semente = 1;
+    auto novo_labirinto = [&] {
+        auto lab = std::make_unique<Labirinto>(largura, largura, config_labirinto);
+        lab->set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+        return lab;
+    };
+
+    // direto
+    std::uint64_t esperado;
+    {
+        const auto lab = novo_labirinto();
+        ColoniaT colonia(*lab, config);
+        for (int i=0; i<iteracoes; i++) colonia.iterar();
+        esperado = assinatura(*lab, colonia);
+    }
+
+    // até o corte, com checkpoint
+    double t_perdido, t_enviar, t_escrita;
+    {
+        const auto lab = novo_labirinto();
+        ColoniaT colonia(*lab, config);
+        t_perdido = cronometrar([&] { for (int i=0; i<corte; i++) colonia.iterar(); });
+        GravadorCheckpoint checkpoints(arquivo);
+        t_enviar = cronometrar([&] { checkpoints.enviar(*lab, colonia, {corte, 0}); });
+        t_escrita = cronometrar([&] { checkpoints.esperar(); });
+    }
+
+    // retomada, com labirinto e colônia novos
+    const auto lab = novo_labirinto();
+    ColoniaT colonia(*lab, config);
+    EstadoExecucao estado;
+    const double t_carregar = cronometrar([&] { estado = carregar_checkpoint(arquivo, *lab, colonia); });
+    for (int i=estado.iteracao; i<iteracoes; i++) colonia.iterar();
+    const bool iguais = estado.iteracao == corte && assinatura(*lab, colonia) == esperado;
+
+    std::FILE* f = std::fopen(arquivo.c_str(), "rb");
+    std::fseek(f, 0, SEEK_END);
+    const double megabytes = static_cast<double>(std::ftell(f)) / (1024.0 * 1024.0);
+    std::fclose(f);
+    std::remove(arquivo.c_str());
+
+    std::cout << nome << ',' << (iguais ? "sim" : "nao") << ',' << t_perdido << ',' << t_enviar << ','
+              << t_escrita << ',' << t_carregar << ',' << (t_enviar + t_escrita + t_carregar) / t_perdido << ','
+              << megabytes << std::endl;
+    return iguais;
+}
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 151;
+    const int iteracoes = argc > 2 ? std::atoi(argv[2]) : 60;
+    const int corte = argc > 3 ? std::atoi(argv[3]) : 30;
+    const int formigas = argc > 4 ? std::atoi(argv[4]) : 50;
+    const std::string arquivo = argc > 5 ? argv[5] : "aco_benchmark.ckpt";
+
+    try {
+        ConfigColonia config;
+        config.n_formigas = formigas;
+        config.intensidade_feromonio = largura * largura * 0.1;
+        config.poda = ModoPoda::ENTRE_ITERACOES;
+        config.encurtar_caminhos = true;
+        config.raio_religacao = 6;
+
+        std::cout << "variante,iguais,iteracoes_ate_corte_s,enviar_s,escrita_s,carregar_s,custo_relativo,arquivo_mb\n";
+        bool iguais = medir<Colonia>("elitista", largura, iteracoes, corte, config, arquivo);
+        iguais &= medir<ColoniaMMAS>("mmas", largura, iteracoes, corte, config, arquivo);
+        iguais &= medir<ColoniaACS>("acs", largura, iteracoes, corte, config, arquivo);
+        iguais &= medir<ColoniaRank>("rank", largura, iteracoes, corte, config, arquivo);
+        return iguais ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        std::remove(arquivo.c_str());
+        return 1;
+    }
+}
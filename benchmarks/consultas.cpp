@@ -0,0 +1,123 @@
+// Vazão do resolver_consultas (Consultas.h): consultas/s com 1..N threads no mesmo labirinto, e o resultado de
+// cada consulta no final. Os pares (ninho, comida) são sorteados entre as células que o ninho do próprio labirinto
+// alcança, então toda consulta tem caminho.
+// Uso: ACO_Consultas [largura] [consultas] [formigas] [iteracoes] [max_threads] [arquivo_labirinto]
+// A coluna "assinatura" tem que ser igual em todas as linhas: se mudar, o resultado depende do número de threads
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../Consultas.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Células que o ninho alcança (BFS), onde os pares são sorteados
+static std::vector<Pos> alcancaveis(const Labirinto& lab) {
+    std::vector<std::uint8_t> visitado(static_cast<size_t>(lab.get_largura()) * lab.get_altura(), 0);
+    std::vector<Pos> fila = {lab.get_pos_ninho()};
+    visitado[lab.indice(fila[0])] = 1;
+    constexpr int DX[4] = {-1, 1, 0, 0};
+    constexpr int DY[4] = {0, 0, -1, 1};
+    for (size_t i=0; i<fila.size(); i++) {
+        for (int d=0; d<4; d++) {
+            const Pos v = {fila[i].x + DX[d], fila[i].y + DY[d]};
+            if (v.x < 0 || v.x >= lab.get_largura() || v.y < 0 || v.y >= lab.get_altura()) continue;
+            if (lab.parede_rapida(v) || visitado[lab.indice(v)]) continue;
+            visitado[lab.indice(v)] = 1;
+            fila.push_back(v);
+        }
+    }
+    return fila;
+}
+
+// FNV-1a dos tamanhos e dos caminhos de todas as consultas
+static std::uint64_t assinatura(const std::vector<ResultadoConsulta>& resultados, const Labirinto& lab) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto misturar = [&h](const std::uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+    for (const ResultadoConsulta& r : resultados) {
+        misturar(static_cast<std::uint64_t>(r.melhor));
+        misturar(static_cast<std::uint64_t>(r.iteracoes));
+        for (const Pos& p : r.melhor_caminho) misturar(static_cast<std::uint64_t>(lab.indice(p)));
+    }
+    return h;
+}
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 151;
+    const int n_consultas = argc > 2 ? std::atoi(argv[2]) : 32;
+    const int formigas = argc > 3 ? std::atoi(argv[3]) : 50;
+    const int iteracoes = argc > 4 ? std::atoi(argv[4]) : 60;
+#ifdef _OPENMP
+    const int max_threads = argc > 5 ? std::atoi(argv[5]) : omp_get_max_threads();
+#else
+    const int max_threads = 1;
+    std::cerr << "Compilado sem OpenMP, medindo apenas 1 thread" << std::endl;
+#endif
+
+    try {
+        std::unique_ptr<Labirinto> base;
+        if (argc > 6) base = std::make_unique<Labirinto>(std::string(argv[6]));
+        else {
+            ConfigLabirinto config_labirinto;
+            config_labirinto.semente = 1;
+            base = std::make_unique<Labirinto>(largura, largura, config_labirinto);
+        }
+        base->set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+
+        const std::vector<Pos> celulas = alcancaveis(*base);
+        std::mt19937 gen(1);
+        std::uniform_int_distribution<size_t> sorteio(0, celulas.size() - 1);
+        std::vector<Consulta> consultas;
+        while (static_cast<int>(consultas.size()) < n_consultas) {
+            const Pos ninho = celulas[sorteio(gen)];
+            const Pos comida = celulas[sorteio(gen)];
+            if (!(ninho == comida)) consultas.push_back({ninho, comida});
+        }
+
+        ConfigColonia config;
+        config.n_formigas = formigas;
+        config.intensidade_feromonio = base->get_largura() * base->get_altura() * 0.1;
+        config.poda = ModoPoda::ENTRE_ITERACOES;
+        config.encurtar_caminhos = true;
+        ConfigConsultas config_consultas;
+        config_consultas.n_iteracoes = iteracoes;
+
+        std::cout << "threads,consultas_por_s,speedup,assinatura\n";
+        std::vector<ResultadoConsulta> resultados;
+        double base_por_s = 0.0;
+        for (int threads=1; threads<=max_threads; threads *= 2) {
+            config_consultas.threads = threads;
+            const auto inicio = std::chrono::steady_clock::now();
+            resultados = resolver_consultas<Colonia>(*base, consultas, config, config_consultas);
+            const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+            const double por_s = n_consultas / segundos;
+            if (threads == 1) base_por_s = por_s;
+            std::cout << threads << ',' << por_s << ',' << por_s / base_por_s << ','
+                      << std::hex << assinatura(resultados, *base) << std::dec << std::endl;
+        }
+
+        std::cout << "\nconsulta,ninho_x,ninho_y,comida_x,comida_y,melhor,iteracao_melhor,iteracoes,segundos\n";
+        for (int i=0; i<n_consultas; i++) {
+            const ResultadoConsulta& r = resultados[i];
+            std::cout << i << ',' << consultas[i].ninho.x << ',' << consultas[i].ninho.y << ','
+                      << consultas[i].comida.x << ',' << consultas[i].comida.y << ',' << r.melhor << ','
+                      << r.iteracao_melhor << ',' << r.iteracoes << ',' << r.segundos << '\n';
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
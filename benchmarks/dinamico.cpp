@@ -0,0 +1,197 @@
+// Labirinto dinâmico (ColoniaAco::alterar_paredes): recomeço quente contra recomeço frio depois de mudar o labirinto.
+// A colônia converge, o labirinto muda e aí:
+//   quente: a mesma colônia continua, com o feromônio que já tinha e o melhor caminho reparado (ou descartado);
+//   frio:   uma colônia nova no labirinto já alterado, com o feromônio zerado.
+// Dois cenários: "fechar" fecha n células do melhor caminho (sem desconectar o ninho da comida) e "abrir" abre as
+// n paredes que mais encurtariam o melhor caminho. "otimo" é o menor caminho de verdade (BFS) depois da mudança, e
+// para o quente e o frio sai quantas iterações/segundos cada um leva até ficar a no máximo tolerancia% do ótimo e
+// até chegar nele (-1 = não chegou antes de estagnar). 0 iterações no quente = o caminho reparado já estava lá.
+// Uso: ACO_Dinamico [largura] [celulas] [formigas] [max_iteracoes] [tolerancia_%]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Colonia.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+
+constexpr int DX[4] = {-1, 1, 0, 0};
+constexpr int DY[4] = {0, 0, -1, 1};
+constexpr int PARADA_POR_ESTAGNACAO = 35;
+
+// Menor caminho do ninho até a comida em células (-1 = desconectado)
+static int menor_caminho_bfs(const Labirinto& lab) {
+    std::vector<int> distancia(static_cast<size_t>(lab.get_largura()) * lab.get_altura(), -1);
+    std::vector<Pos> fila = {lab.get_pos_ninho()};
+    distancia[lab.indice(fila[0])] = 1;
+    for (size_t i=0; i<fila.size(); i++) {
+        if (fila[i] == lab.get_pos_comida()) return distancia[lab.indice(fila[i])];
+        for (int d=0; d<4; d++) {
+            const Pos v = {fila[i].x + DX[d], fila[i].y + DY[d]};
+            if (v.x < 0 || v.x >= lab.get_largura() || v.y < 0 || v.y >= lab.get_altura()) continue;
+            if (lab.parede_rapida(v) || distancia[lab.indice(v)] != -1) continue;
+            distancia[lab.indice(v)] = distancia[lab.indice(fila[i])] + 1;
+            fila.push_back(v);
+        }
+    }
+    return -1;
+}
+
+// Células do melhor caminho a fechar, espalhadas pelo meio dele, pulando as que desconectariam o labirinto
+static std::vector<AlteracaoParede> escolher_fechamentos(const Labirinto& lab, const std::vector<Pos>& caminho,
+                                                         const int n) {
+    Labirinto teste = lab; // a cópia ganha paredes próprias no primeiro set_parede
+    std::vector<AlteracaoParede> alteracoes;
+    const int tamanho = static_cast<int>(caminho.size());
+    for (int k=0; k<tamanho-2 && static_cast<int>(alteracoes.size()) < n; k++) {
+        // começa no meio e vai alternando para os dois lados
+        const int i = tamanho/2 + (k % 2 ? -(k+1)/2 : k/2);
+        if (i <= 0 || i >= tamanho-1) continue;
+        teste.set_parede(caminho[i], true);
+        if (menor_caminho_bfs(teste) == -1) teste.set_parede(caminho[i], false);
+        else alteracoes.push_back({caminho[i], true});
+    }
+    return alteracoes;
+}
+
+// Paredes entre duas células do melhor caminho, as que pulam o trecho maior primeiro
+static std::vector<AlteracaoParede> escolher_aberturas(const Labirinto& lab, const std::vector<Pos>& caminho,
+                                                       const int n) {
+    std::vector<int> posicao(static_cast<size_t>(lab.get_largura()) * lab.get_altura(), -1);
+    for (int i=0; i<static_cast<int>(caminho.size()); i++) posicao[lab.indice(caminho[i])] = i;
+
+    std::vector<std::pair<int, Pos>> candidatas; // (ganho, parede)
+    for (int x=1; x<lab.get_largura()-1; x++) {
+        for (int y=1; y<lab.get_altura()-1; y++) {
+            if (!lab.parede_rapida({x, y})) continue;
+            int menor = -1, maior = -1;
+            for (int d=0; d<4; d++) {
+                const int i = posicao[lab.indice({x + DX[d], y + DY[d]})];
+                if (i == -1) continue;
+                if (menor == -1 || i < menor) menor = i;
+                if (i > maior) maior = i;
+            }
+            if (maior - menor > 2) candidatas.push_back({maior - menor - 2, {x, y}});
+        }
+    }
+    std::ranges::sort(candidatas, [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<AlteracaoParede> alteracoes;
+    for (int i=0; i<n && i<static_cast<int>(candidatas.size()); i++) alteracoes.push_back({candidatas[i].second, false});
+    return alteracoes;
+}
+
+struct Recuperacao {
+    int melhor = -1;
+    int iteracoes = 0;
+    double segundos = 0.0;
+    std::vector<int> melhor_por_iteracao;
+    std::vector<double> tempo_por_iteracao; // acumulado
+};
+
+// Itera até estagnar (ou max_iteracoes), guardando o melhor global e o tempo depois de cada iteração
+static Recuperacao rodar(Colonia& colonia, const int max_iteracoes) {
+    Recuperacao r;
+    const auto inicio = std::chrono::steady_clock::now();
+    int estagnacao = 0;
+    while (r.iteracoes < max_iteracoes && estagnacao < PARADA_POR_ESTAGNACAO) {
+        const ResultadoIteracao iteracao = colonia.iterar();
+        r.iteracoes++;
+        estagnacao = iteracao.melhorou_global ? 0 : estagnacao + 1;
+        r.melhor_por_iteracao.push_back(colonia.get_menor_tamanho_global());
+        r.tempo_por_iteracao.push_back(
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+    }
+    r.melhor = colonia.get_menor_tamanho_global();
+    r.segundos = r.tempo_por_iteracao.empty() ? 0.0 : r.tempo_por_iteracao.back();
+    return r;
+}
+
+// Iterações e segundos até o melhor global ficar <= alvo ({-1, -1} = não chegou). Antes da primeira iteração vale
+// o melhor que a colônia já tinha (o reparado, no quente)
+static std::pair<int, double> ate_chegar(const Recuperacao& r, const int melhor_inicial, const int alvo) {
+    if (melhor_inicial != -1 && melhor_inicial <= alvo) return {0, 0.0};
+    for (int i=0; i<r.iteracoes; i++) {
+        if (r.melhor_por_iteracao[i] != -1 && r.melhor_por_iteracao[i] <= alvo) return {i + 1, r.tempo_por_iteracao[i]};
+    }
+    return {-1, -1.0};
+}
+
+static const char* nome_efeito(const EfeitoAlteracao efeito) {
+    switch (efeito) {
+        case EfeitoAlteracao::INTACTO: return "intacto";
+        case EfeitoAlteracao::REPARADO: return "reparado";
+        case EfeitoAlteracao::DESCARTADO: return "descartado";
+    }
+    return "?";
+}
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 151;
+    const int n_celulas = argc > 2 ? std::atoi(argv[2]) : 3;
+    const int formigas = argc > 3 ? std::atoi(argv[3]) : 100;
+    const int max_iteracoes = argc > 4 ? std::atoi(argv[4]) : 300;
+    const double tolerancia = argc > 5 ? std::atof(argv[5]) : 5.0;
+
+    try {
+        ConfigLabirinto config_labirinto;
+        config_labirinto.semente = 1;
+
+        ConfigColonia config;
+        config.n_formigas = formigas;
+        config.intensidade_feromonio = largura * largura * 0.1;
+        config.poda = ModoPoda::ENTRE_ITERACOES;
+        config.encurtar_caminhos = true;
+        config.raio_religacao = 6;
+
+        std::cout << "cenario,celulas,efeito,antes,reparado,otimo,variante,melhor,iteracoes,segundos,"
+                     "ate_tolerancia_iteracoes,ate_tolerancia_s,ate_otimo_iteracoes,ate_otimo_s\n";
+        for (const std::string cenario : {"fechar", "abrir"}) {
+            Labirinto lab(largura, largura, config_labirinto);
+            lab.set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+            Colonia colonia(lab, config);
+            rodar(colonia, max_iteracoes);
+            const int antes = colonia.get_menor_tamanho_global();
+            if (antes == -1) throw std::runtime_error("A colonia nao convergiu antes da mudanca");
+
+            std::vector<Pos> caminho;
+            colonia.get_melhor_caminho_global().decodificar(caminho);
+            const std::vector<AlteracaoParede> alteracoes = cenario == "fechar"
+                ? escolher_fechamentos(lab, caminho, n_celulas)
+                : escolher_aberturas(lab, caminho, n_celulas);
+
+            // quente: a mesma colônia continua
+            const EfeitoAlteracao efeito = colonia.alterar_paredes(alteracoes);
+            const int reparado = colonia.get_menor_tamanho_global();
+            const int otimo = menor_caminho_bfs(lab);
+            const Recuperacao quente = rodar(colonia, max_iteracoes);
+
+            // frio: colônia nova, feromônio zerado, no labirinto já alterado
+            Labirinto lab_frio = lab;
+            lab_frio.reiniciar_feromonios();
+            Colonia colonia_fria(lab_frio, config);
+            const Recuperacao frio = rodar(colonia_fria, max_iteracoes);
+
+            const int alvo_tolerancia = static_cast<int>(otimo * (1.0 + tolerancia / 100.0));
+            const auto imprimir = [&](const char* variante, const Recuperacao& r, const int melhor_inicial) {
+                const auto [tolerancia_it, tolerancia_s] = ate_chegar(r, melhor_inicial, alvo_tolerancia);
+                const auto [otimo_it, otimo_s] = ate_chegar(r, melhor_inicial, otimo);
+                std::cout << cenario << ',' << alteracoes.size() << ',' << nome_efeito(efeito) << ',' << antes << ','
+                          << reparado << ',' << otimo << ',' << variante << ',' << r.melhor << ',' << r.iteracoes
+                          << ',' << r.segundos << ',' << tolerancia_it << ',' << tolerancia_s << ',' << otimo_it
+                          << ',' << otimo_s << std::endl;
+            };
+            imprimir("quente", quente, reparado);
+            imprimir("frio", frio, -1);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Relatório de escalabilidade da fase de construção: formigas/s com 1..N threads.
+// Uso: ACO_Escalabilidade [largura] [iteracoes] [max_threads]
+// A coluna "assinatura" tem que ser igual em todas as linhas: se mudar, o resultado depende do número de threads
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "../Colonia.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Resume o estado da colônia num número só (FNV-1a do melhor caminho e de todos os feromônios)
+static std::uint64_t assinatura(const Colonia& colonia, const Labirinto& lab) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto misturar = [&h](const std::uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+    misturar(static_cast<std::uint64_t>(colonia.get_menor_tamanho_global()));
+    for (const Pos& p : colonia.get_melhor_caminho_global()) {
+        misturar(static_cast<std::uint64_t>(lab.indice(p)));
+    }
+    for (int i=0; i<lab.get_largura(); i++) {
+        for (int j=0; j<lab.get_altura(); j++) {
+            const double f = lab.get_feromonio({i, j});
+            std::uint64_t bits;
+            static_assert(sizeof(bits) == sizeof(f));
+            std::memcpy(&bits, &f, sizeof(f));
+            misturar(bits);
+        }
+    }
+    return h;
+}
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 150;
+    const int iteracoes = argc > 2 ? std::atoi(argv[2]) : 10;
+#ifdef _OPENMP
+    const int max_threads = argc > 3 ? std::atoi(argv[3]) : omp_get_max_threads();
+#else
+    const int max_threads = 1;
+    std::cerr << "Compilado sem OpenMP, medindo apenas 1 thread" << std::endl;
+#endif
+
+    ConfigLabirinto config_labirinto;
+    config_labirinto.semente = 1;
+    const Labirinto base(largura, largura, config_labirinto);
+
+    ConfigColonia config;
+    config.intensidade_feromonio = largura * largura * 0.1;
+
+    std::cout << "threads,formigas_por_s,speedup,assinatura\n";
+    double base_formigas_por_s = 0.0;
+    for (int threads=1; threads<=max_threads; threads++) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+        Labirinto lab = base; // cada rodada começa do mesmo campo de feromônio
+        Colonia colonia(lab, config);
+
+        double segundos_construcao = 0.0;
+        for (int it=0; it<iteracoes; it++) {
+            const auto inicio = std::chrono::steady_clock::now();
+            colonia.construir_solucoes();
+            const auto fim = std::chrono::steady_clock::now();
+            segundos_construcao += std::chrono::duration<double>(fim - inicio).count();
+            colonia.atualizar_feromonios();
+        }
+
+        const double formigas_por_s = config.n_formigas * iteracoes / segundos_construcao;
+        if (threads == 1) base_formigas_por_s = formigas_por_s;
+
+        std::cout << threads << ',' << formigas_por_s << ',' << formigas_por_s / base_formigas_por_s << ','
+                  << std::hex << assinatura(colonia, lab) << std::dec << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Ilhas contra uma colônia só com o mesmo total de formigas: K ilhas de N formigas vs 1 colônia de K*N formigas,
+// mesmo número de iterações, algumas sementes. Mostra o melhor caminho e o tempo de cada um.
+// Uso: ACO_Ilhas [largura] [ilhas] [formigas_por_ilha] [iteracoes] [sementes] [anel|completa] [caminho|mistura]
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../Arquipelago.h"
+#include "../Colonia.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+#include "Cronometragem.h"
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 301;
+    const int n_ilhas = argc > 2 ? std::atoi(argv[2]) : 4;
+    const int formigas_por_ilha = argc > 3 ? std::atoi(argv[3]) : 50;
+    const int iteracoes = argc > 4 ? std::atoi(argv[4]) : 100;
+    const int sementes = argc > 5 ? std::atoi(argv[5]) : 3;
+    const bool completa = argc > 6 && std::strcmp(argv[6], "completa") == 0;
+    const bool mistura = argc > 7 && std::strcmp(argv[7], "mistura") == 0;
+
+    ConfigLabirinto config_labirinto;
+    config_labirinto.algoritmo = AlgoritmoLabirinto::PILARES_DIFICIL;
+    config_labirinto.semente = 1;
+    Labirinto base(largura, largura, config_labirinto);
+    base.set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+
+    std::cout << "modo,ilhas,formigas_total,semente,melhor,iteracoes,segundos\n";
+    for (int s=0; s<sementes; s++) {
+        ConfigColonia config;
+        config.intensidade_feromonio = largura * largura * 0.1;
+        config.poda = ModoPoda::ENTRE_ITERACOES;
+        config.semente = 42 + s;
+
+        // uma colônia com todas as formigas
+        {
+            ConfigColonia config_unica = config;
+            config_unica.n_formigas = formigas_por_ilha * n_ilhas;
+            Labirinto lab = base;
+            Colonia colonia(lab, config_unica);
+            const double segundos = cronometrar([&] {
+                for (int it=0; it<iteracoes; it++) colonia.iterar();
+            });
+            std::cout << "unica,1," << config_unica.n_formigas << ',' << config.semente << ','
+                      << colonia.get_menor_tamanho_global() << ',' << iteracoes << ',' << segundos << '\n';
+        }
+
+        // ilhas
+        {
+            ConfigColonia config_ilha = config;
+            config_ilha.n_formigas = formigas_por_ilha;
+            ConfigIlhas config_ilhas;
+            config_ilhas.n_ilhas = n_ilhas;
+            config_ilhas.topologia = completa ? TopologiaIlhas::COMPLETA : TopologiaIlhas::ANEL;
+            config_ilhas.migracao = mistura ? MigracaoIlhas::MISTURA_FEROMONIO : MigracaoIlhas::MELHOR_CAMINHO;
+
+            Arquipelago<Colonia> arquipelago(base, config_ilha, config_ilhas);
+            ResultadoArquipelago resultado;
+            const double segundos = cronometrar([&] { resultado = arquipelago.executar(iteracoes); });
+            std::cout << "ilhas," << n_ilhas << ',' << formigas_por_ilha * n_ilhas << ',' << config.semente << ','
+                      << resultado.melhor_geral << ',' << resultado.iteracoes << ',' << segundos << '\n';
+        }
+        std::cout.flush();
+    }
+    return 0;
+}
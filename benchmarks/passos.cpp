@@ -0,0 +1,199 @@
+// Microbenchmark do passo da formiga: passos/s do Formiga::mover atual contra o passo antigo, que alocava os
+// vetores de caminhos e chances e criava uma std::discrete_distribution a cada passo.
+// A linha "grafo" roda as mesmas formigas no GrafoJuncoes: a coluna passos mostra quantas decisões sobram quando
+// os corredores viram uma aresta só.
+// As linhas colonia_* são a fase de construção da Colonia com cada MotorFormigas (LoteFormigas.h). As três andam
+// exatamente os mesmos caminhos, então a coluna passos tem que ser igual nelas.
+// Uso: ACO_Passos [largura] [repeticoes] [algoritmo do labirinto, 0..4 como no AlgoritmoLabirinto]
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../Colonia.h"
+#include "../ColoniaGrafo.h"
+#include "../Formiga.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+
+constexpr double ALFA = 1.0;
+constexpr double BETA = 4.0;
+constexpr int N_FORMIGAS = 100;
+
+// Cópia do passo como ele era antes (3 alocações + discrete_distribution por passo), só para comparação
+class FormigaLegada {
+public:
+    FormigaLegada(const Labirinto& lab, const std::uint64_t semente)
+        :   lab(lab),
+            gen(semente),
+            pos_atual(lab.get_pos_ninho()),
+            matriz_exploracao(lab.get_largura(), std::vector<bool>(lab.get_altura(), false))
+    {
+        matriz_exploracao[pos_atual.x][pos_atual.y] = true;
+        pilha_solucao.push_back(pos_atual);
+    }
+
+    [[nodiscard]] bool terminou() const { return encontrou || fracassou; }
+
+    void mover() {
+        const std::vector<Pos> caminhos = get_caminhos_validos();
+        if (caminhos.empty()) {
+            if (pilha_solucao.size() < 2) {
+                fracassou = true;
+                return;
+            }
+            pilha_solucao.pop_back();
+            pos_atual = pilha_solucao.back();
+            return;
+        }
+        const std::vector<double> chances = calcular_chance(caminhos);
+        std::discrete_distribution<> dist(chances.begin(), chances.end());
+        pos_atual = caminhos[dist(gen)];
+        pilha_solucao.push_back(pos_atual);
+        matriz_exploracao[pos_atual.x][pos_atual.y] = true;
+        if (pos_atual == lab.get_pos_comida()) encontrou = true;
+    }
+
+private:
+    [[nodiscard]] std::vector<Pos> get_caminhos_validos() const {
+        std::vector<Pos> caminhos;
+        caminhos.reserve(4);
+        const std::vector<Pos> movimentos = {
+            {pos_atual.x - 1, pos_atual.y}, {pos_atual.x + 1, pos_atual.y},
+            {pos_atual.x, pos_atual.y - 1}, {pos_atual.x, pos_atual.y + 1}
+        };
+        for (const Pos& p : movimentos) {
+            if (p.x < 0 || p.x >= lab.get_largura() || p.y < 0 || p.y >= lab.get_altura()) continue;
+            if (!lab.parede_rapida(p) && !matriz_exploracao[p.x][p.y]) caminhos.push_back(p);
+        }
+        return caminhos;
+    }
+
+    [[nodiscard]] std::vector<double> calcular_chance(const std::vector<Pos>& caminhos) const {
+        std::vector<double> valores;
+        valores.reserve(caminhos.size());
+        const Pos comida = lab.get_pos_comida();
+        for (const Pos& p : caminhos) {
+            const double feromonio = std::max(lab.feromonio_rapido(p), 1e-10);
+            const int dist = std::abs(p.x - comida.x) + std::abs(p.y - comida.y);
+            const double heuristica = 1.0 / (static_cast<double>(dist) + 1e-5);
+            valores.push_back(std::pow(feromonio, ALFA) * std::pow(heuristica, BETA));
+        }
+        const double soma = std::accumulate(valores.begin(), valores.end(), 0.0);
+        for (double& v : valores) v /= soma;
+        return valores;
+    }
+
+    const Labirinto& lab;
+    GeradorAleatorio gen;
+    Pos pos_atual;
+    bool encontrou = false, fracassou = false;
+    std::vector<Pos> pilha_solucao;
+    std::vector<std::vector<bool>> matriz_exploracao;
+};
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 150;
+    const int repeticoes = argc > 2 ? std::atoi(argv[2]) : 5;
+    const long long max_passos = 2LL * largura * largura;
+
+    ConfigLabirinto config_labirinto;
+    config_labirinto.semente = 1;
+    if (argc > 3) config_labirinto.algoritmo = static_cast<AlgoritmoLabirinto>(std::atoi(argv[3]));
+    Labirinto lab(largura, largura, config_labirinto);
+
+    std::cout << "kernel,passos,segundos,passos_por_s\n";
+
+    // legado: a FormigaLegada é criada dentro do loop, mas isso fica fora da medição do passo
+    {
+        long long passos = 0;
+        double segundos = 0.0;
+        for (int r=0; r<repeticoes; r++) {
+            for (int i=0; i<N_FORMIGAS; i++) {
+                FormigaLegada formiga(lab, GeradorAleatorio::para_fluxo(1, i, r)());
+                long long passos_formiga = 0;
+                const auto inicio = std::chrono::steady_clock::now();
+                while (!formiga.terminou() && passos_formiga <= max_passos) {
+                    formiga.mover();
+                    passos_formiga++;
+                }
+                segundos += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                passos += passos_formiga;
+            }
+        }
+        std::cout << "legado," << passos << ',' << segundos << ',' << passos / segundos << '\n';
+    }
+
+    // atual: sem alocação por passo, roleta com 1 sorteio
+    {
+        std::vector<Formiga> formigas;
+        formigas.reserve(N_FORMIGAS);
+        for (int i=0; i<N_FORMIGAS; i++) formigas.emplace_back(lab, ALFA, BETA);
+
+        long long passos = 0;
+        double segundos = 0.0;
+        for (int r=0; r<repeticoes; r++) {
+            for (int i=0; i<N_FORMIGAS; i++) {
+                Formiga& formiga = formigas[i];
+                formiga.semear(1, i, r);
+                formiga.reset();
+                const auto inicio = std::chrono::steady_clock::now();
+                passos += formiga.andar(max_passos);
+                segundos += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            }
+        }
+        std::cout << "atual," << passos << ',' << segundos << ',' << passos / segundos << '\n';
+    }
+
+    // construção da Colonia com cada motor, também sem depositar
+    const std::pair<const char*, MotorFormigas> motores[] = {
+        {"colonia_escalar", MotorFormigas::ESCALAR},
+        {"colonia_lote", MotorFormigas::LOTE},
+        {"colonia_lote_sem_simd", MotorFormigas::LOTE_SEM_SIMD}
+    };
+    for (const auto& [nome, motor] : motores) {
+        ConfigColonia config;
+        config.n_formigas = N_FORMIGAS;
+        config.alfa = ALFA;
+        config.beta = BETA;
+        config.max_passos_timeout = static_cast<int>(max_passos);
+        config.motor = motor;
+        Labirinto lab_colonia = lab;
+        Colonia colonia(lab_colonia, config);
+
+        long long passos = 0;
+        double segundos = 0.0;
+        for (int r=0; r<repeticoes; r++) {
+            const auto inicio = std::chrono::steady_clock::now();
+            colonia.construir_solucoes();
+            segundos += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            passos += colonia.get_passos_ultima_iteracao();
+        }
+        std::cout << nome << ',' << passos << ',' << segundos << ',' << passos / segundos << '\n';
+    }
+
+    // grafo de junções: só a fase de construção, sem depositar, para ficar comparável com as de cima
+    {
+        ConfigColonia config;
+        config.n_formigas = N_FORMIGAS;
+        config.alfa = ALFA;
+        config.beta = BETA;
+        config.max_passos_timeout = static_cast<int>(max_passos);
+        ColoniaGrafo colonia(lab, config);
+
+        long long passos = 0;
+        double segundos = 0.0;
+        for (int r=0; r<repeticoes; r++) {
+            const auto inicio = std::chrono::steady_clock::now();
+            colonia.construir_solucoes();
+            segundos += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            passos += colonia.get_passos_ultima_iteracao();
+        }
+        std::cout << "grafo," << passos << ',' << segundos << ',' << passos / segundos << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Snapshots de labirinto grande com a pirâmide do feromônio (PiramideFeromonio.h). Compara, por snapshot, a cópia
+// inteira (copiar_feromonios, o que o GravadorSnapshots v1 faz) com um nível da pirâmide e com uma região, em tempo
+// e em bytes. Também mede quanto a pirâmide ativada custa a mais em cada iteração da colônia (as duas execuções têm
+// a mesma semente, então fazem exatamente o mesmo trabalho) e confere o exportado com a redução força bruta dos
+// blocos: os dois têm que ser iguais, a menos do arredondamento para float ("erro_media" é o maior erro relativo)
+// Uso: ACO_Piramide [largura] [iteracoes] [formigas] [nivel] [lado_regiao]
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "../Colonia.h"
+#include "../GeradorLabirinto.h"
+#include "../Labirinto.h"
+#include "../PiramideFeromonio.h"
+#include "Cronometragem.h"
+
+// Segundos por snapshot (média de algumas repetições)
+template<class F>
+static double por_snapshot(F&& f) {
+    constexpr int REPETICOES = 20;
+    return cronometrar([&] { for (int i=0; i<REPETICOES; i++) f(); }) / REPETICOES;
+}
+
+struct Conferencia {
+    bool maximo_exato = true;
+    bool media_exata = true;
+    double erro_media = 0.0;
+};
+
+// Reduz as células de verdade (copiar_feromonios) em blocos de 2^nivel e compara com o exportado
+static Conferencia conferir(const Labirinto& lab, const int nivel) {
+    const int largura = lab.get_largura(), altura = lab.get_altura();
+    std::vector<float> celulas(static_cast<size_t>(largura) * altura);
+    lab.copiar_feromonios(celulas.data());
+
+    const RegiaoPiramide blocos = regiao_no_nivel({}, nivel, largura, altura);
+    const size_t n_blocos = static_cast<size_t>(blocos.largura) * blocos.altura;
+    std::vector<float> maximo(n_blocos), media(n_blocos);
+    lab.exportar_piramide(nivel, blocos, maximo.data(), media.data());
+
+    Conferencia conferencia;
+    const int lado = 1 << nivel;
+    for (int bx=0; bx<blocos.largura; bx++) {
+        for (int by=0; by<blocos.altura; by++) {
+            float maior = 0.0f;
+            double soma = 0.0;
+            int livres = 0;
+            for (int x=bx*lado; x<std::min((bx + 1)*lado, largura); x++) {
+                for (int y=by*lado; y<std::min((by + 1)*lado, altura); y++) {
+                    if (lab.parede_rapida({x, y})) continue;
+                    const float v = celulas[lab.indice({x, y})];
+                    maior = livres == 0 ? v : std::max(maior, v);
+                    soma += v;
+                    livres++;
+                }
+            }
+            const size_t i = static_cast<size_t>(bx) * blocos.altura + by;
+            if (maximo[i] != maior) conferencia.maximo_exato = false;
+            if (livres == 0) continue;
+            const double exata = soma / livres;
+            // as células já vêm arredondadas para float, então dá uma folga do tamanho desse arredondamento
+            if (std::abs(exata - media[i]) > exata * 1e-6) conferencia.media_exata = false;
+            conferencia.erro_media = std::max(conferencia.erro_media, std::abs(exata - media[i]) / exata);
+        }
+    }
+    return conferencia;
+}
+
+int main(int argc, char* argv[]) {
+    const int largura = argc > 1 ? std::atoi(argv[1]) : 1001;
+    const int iteracoes = argc > 2 ? std::atoi(argv[2]) : 10;
+    const int formigas = argc > 3 ? std::atoi(argv[3]) : 10;
+    const int nivel = argc > 4 ? std::atoi(argv[4]) : 3;
+    const int lado_regiao = argc > 5 ? std::atoi(argv[5]) : 256;
+
+    try {
+        ConfigLabirinto config_labirinto;
+        config_labirinto.semente = 1;
+        ConfigColonia config;
+        config.n_formigas = formigas;
+        config.intensidade_feromonio = largura * largura * 0.1;
+        config.poda = ModoPoda::ENTRE_ITERACOES;
+        config.encurtar_caminhos = true;
+        config.raio_religacao = 6;
+
+        // colônia sem e com a pirâmide, com o mesmo labirinto e a mesma semente
+        Labirinto sem(largura, largura, config_labirinto);
+        sem.set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+        Labirinto lab = sem;
+        lab.ativar_piramide();
+        Colonia colonia_sem(sem, config);
+        Colonia colonia(lab, config);
+        double t_sem = 0.0, t_com = 0.0, t_nivel_iteracoes = 0.0;
+        std::vector<float> saida(2 * static_cast<size_t>(largura) * largura);
+        const RegiaoPiramide inteiro = regiao_no_nivel({}, nivel, largura, largura);
+        for (int i=0; i<iteracoes; i++) {
+            t_sem += cronometrar([&] { (void) colonia_sem.iterar(); });
+            t_com += cronometrar([&] { (void) colonia.iterar(); });
+            // como no main: um snapshot por iteração, a parte da pirâmide que foi anotada é aplicada aqui
+            const size_t n = static_cast<size_t>(inteiro.largura) * inteiro.altura;
+            t_nivel_iteracoes += cronometrar([&] { lab.exportar_piramide(nivel, inteiro, saida.data(),
+                                                                         saida.data() + n); });
+        }
+
+        std::cout << "iteracao_sem_piramide_s,iteracao_com_piramide_s,sobrecusto,snapshot_nivel_na_iteracao_s\n";
+        std::cout << t_sem / iteracoes << ',' << t_com / iteracoes << ',' << (t_com - t_sem) / t_sem << ','
+                  << t_nivel_iteracoes / iteracoes << "\n\n";
+
+        // custo e tamanho de cada snapshot
+        const RegiaoPiramide celulas_regiao = {(largura - lado_regiao) / 2, (largura - lado_regiao) / 2,
+                                               lado_regiao, lado_regiao};
+        struct Exportacao {
+            const char* nome;
+            int nivel;
+            RegiaoPiramide regiao;
+        };
+        const Exportacao exportacoes[] = {
+            {"nivel_0_inteiro", 0, {}},
+            {"nivel_k_inteiro", nivel, {}},
+            {"nivel_0_regiao", 0, celulas_regiao},
+            {"nivel_k_regiao", nivel, celulas_regiao},
+        };
+        std::cout << "snapshot,nivel,blocos,bytes,segundos,relativo_copia\n";
+        const double t_copia = por_snapshot([&] { lab.copiar_feromonios(saida.data()); });
+        std::cout << "copia_v1,0," << static_cast<size_t>(largura) * largura << ','
+                  << static_cast<size_t>(largura) * largura * sizeof(float) << ',' << t_copia << ",1\n";
+        for (const Exportacao& e : exportacoes) {
+            const RegiaoPiramide blocos = regiao_no_nivel(e.regiao, e.nivel, largura, largura);
+            const size_t n = static_cast<size_t>(blocos.largura) * blocos.altura;
+            const double t = por_snapshot([&] {
+                lab.exportar_piramide(e.nivel, blocos, saida.data(), saida.data() + n);
+            });
+            std::cout << e.nome << ',' << e.nivel << ',' << n << ',' << 2 * n * sizeof(float) << ',' << t << ','
+                      << t / t_copia << '\n';
+        }
+
+        std::cout << "\nnivel,maximo_exato,media_exata,erro_media\n";
+        bool ok = true;
+        for (int k=1; k<lab.get_niveis_piramide(); k++) {
+            const Conferencia c = conferir(lab, k);
+            ok &= c.maximo_exato && c.media_exata;
+            std::cout << k << ',' << (c.maximo_exato ? "sim" : "nao") << ',' << (c.media_exata ? "sim" : "nao")
+                      << ',' << c.erro_media << '\n';
+        }
+        return ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,179 +1,214 @@
 #include <iostream>
-#include <vector>
 #include <chrono>
-#include <iomanip>
 #include <fstream>
-#include <sstream>
-
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Arquipelago.h"
+#include "Checkpoint.h"
+#include "Colonia.h"
+#include "ColoniaGrafo.h"
+#include "Configuracao.h"
 #include "Labirinto.h"
-#include "Formiga.h"
-
-constexpr int LARGURA_LAB = 150;
-constexpr int ALTURA_LAB = 150;
-constexpr int N_ITERACOES = 350;
-constexpr int N_FORMIGAS = 100;
-constexpr double ALFA = 1.0;  // Peso do feromônio
-constexpr double BETA = 4.0;  // Peso da heurística
-constexpr double TAXA_EVAPORACAO = 0.35; // Taxa de evaporação do feromônio
-constexpr double INTENSIDADE_FEROMONIO = LARGURA_LAB * ALTURA_LAB * 0.1; // Valor base do deposito de feromonio
-constexpr double MIN_FEROMONIO = 0.01; // Feromônio mínimo no bloco
-constexpr int SALVAR_ITERACAO = 2; // de quantas em quantas iterações ele vai criar um arquivo
-constexpr bool LABIRINTO_DIFICIL = true; // Labirinto gera com paredes adicionais, tornando o caminho menos previsivel
-// a chance de ser gerada uma parede é de 20% para cada chão adjacente a um pilar.
-// Isto pode aumentar a complexidade do código, e o código vai gerar labirintos até gerar um labirinto possível
-
-// Switch de segurança, não passa de X passos, esse valor é dinâmico para a largura e a altura do labirinto
-constexpr int MAX_PASSOS_TIMEOUT = LARGURA_LAB * ALTURA_LAB * 2;
-constexpr int PARADA_POR_ESTAGNACAO = 35; // quantas iterações sem melhora para parar o código, -1 para desativar
-constexpr int ELITE = 5; // quantas formigas que vão depositar feromonios
-
-void salvar_iteracao(const Labirinto& lab, const std::string& arquivo) {
-    std::ofstream arq_out(arquivo);
-    if (!arq_out.is_open()) {
-        std::cerr << "ERRO! Nao foi possivel criar o arquivo " << arquivo << std::endl;
-        return;
+#include "Metricas.h"
+#include "Varredura.h"
+#include "Visualizacao.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Os hiperparâmetros (tamanho do labirinto, formigas, alfa, beta, evaporação, elite, variante...) estão no
+// ConfigExecucao (Configuracao.h), com os mesmos valores padrão que eram as constantes daqui. Eles vêm da linha de
+// comando e/ou de um arquivo:
+//   ACO_Labirinto --config=experimento.cfg --n_formigas=200 --variante=mmas
+// e --ajuda lista todas as chaves. Uma chave com lista (--alfa=0.5,1,2 --beta=2,4) roda a varredura (Varredura.h):
+// um labirinto só e todas as combinações ao mesmo tempo, com o resumo em saida_varredura.
+// O detalhe de cada iteração (tempos, passos, retrocessos...) vai para ../visualizacao/metricas.jsonl.
+// Execução longa: --checkpoint=estado.ckpt salva tudo a cada intervalo_checkpoint iterações, e depois de uma
+// interrupção --retomar=estado.ckpt (com o resto da configuração igual) continua de onde parou
+// Labirinto grande: --nivel_snapshot=3 salva blocos de 8x8 (máximo e média) em vez das células, e
+// --regiao_snapshot=x:y:largura:altura só um pedaço do labirinto
+
+// Loop principal, igual para a Colonia normal e para a ColoniaGrafo (que não tem checkpoint)
+template<class ColoniaT>
+void executar(ColoniaT& colonia, Labirinto& lab, const ConfigExecucao& config) {
+    constexpr bool TEM_CHECKPOINT = !std::is_same_v<ColoniaT, ColoniaGrafo>;
+
+#ifdef _WIN32
+    system("if not exist ..\\visualizacao mkdir ..\\visualizacao");
+    system("del /Q ..\\visualizacao\\iter_*.csv 2>nul");
+#else
+    system("mkdir -p ../visualizacao");
+    // sobra da versão que salvava um CSV por iteração (só os iter_*, o varredura.csv fica)
+    system("rm -f ../visualizacao/iter_*.csv");
+#endif
+
+    int iteracao = 0, estagnacao = 0;
+    std::unique_ptr<GravadorCheckpoint> checkpoints;
+    if constexpr (TEM_CHECKPOINT) {
+        if (!config.retomar.empty()) {
+            const EstadoExecucao estado = carregar_checkpoint(config.retomar, lab, colonia);
+            iteracao = estado.iteracao;
+            estagnacao = estado.estagnacao;
+            std::cout << "RETOMANDO DA ITERACAO " << iteracao+1 << std::endl;
+        }
+        if (!config.checkpoint.empty()) checkpoints = std::make_unique<GravadorCheckpoint>(config.checkpoint);
     }
 
-    for (int i=0; i<lab.get_largura(); i++) {
-        for (int j=0; j<lab.get_altura(); j++) {
-            Pos p = {i, j};
+    // retomando, as métricas e os snapshots continuam nos arquivos da execução interrompida em vez de apagar eles
+    const int continuar_da_iteracao = config.retomar.empty() ? -1 : iteracao;
+
+    // todos os snapshots vão para um arquivo binário só, escrito em outra thread (formato no Visualizacao.h)
+    // com nivel_snapshot/regiao_snapshot vai só aquele nível da pirâmide, que se ativa no primeiro enviar
+    GravadorSnapshots snapshots("../visualizacao/snapshots.bin", lab, config.nivel_snapshot, config.regiao_snapshot,
+                                continuar_da_iteracao);
+    // salva a inicial antes das formigas andarem nele (na retomada ela já está no arquivo)
+    if (continuar_da_iteracao == -1) snapshots.enviar(lab, iteracao);
+
+    // compilado com ACO_METRICAS=0 não cria o arquivo
+    std::unique_ptr<GravadorMetricas> gravador;
+    if constexpr (METRICAS_ATIVAS) {
+        gravador = std::make_unique<GravadorMetricas>("../visualizacao/metricas.jsonl", continuar_da_iteracao);
+    }
 
-            switch (lab.get_valor_grid(p)) {
-                case 1:
-                    arq_out << -1;
-                    break;
+    while (iteracao<config.n_iteracoes) { // a outra condição de parada é a estagnação, no final do loop da pra ver
+        const ResultadoIteracao resultado = colonia.iterar();
+        MetricasIteracao metricas = colonia.get_metricas();
+
+        // sem std::endl aqui, o flush a cada linha custava mais que a própria iteração em labirinto pequeno
+        if ((iteracao+1) % config.imprimir_iteracao == 0 || iteracao == 0) {
+            std::cout << iteracao+1 << '/' << config.n_iteracoes << " | melhor da iteracao: ";
+            if (resultado.menor_tamanho_iteracao == -1) std::cout << "nenhuma solucao";
+            else std::cout << resultado.menor_tamanho_iteracao;
+            std::cout << " | melhor global: " << colonia.get_menor_tamanho_global();
+            if (config.colonia.poda != ModoPoda::DESLIGADA) std::cout << " | podadas: " << resultado.n_podadas;
+            std::cout << '\n';
+        }
 
-                case 2:
-                    arq_out << -2;
-                    break;
+        if (((iteracao+1) % config.salvar_iteracao == 0 || (iteracao+1) == config.n_iteracoes-1) && iteracao!=0) {
+            Cronometro cronometro(metricas.t_snapshot); // só a cópia, a escrita no disco fica na outra thread
+            if constexpr (std::is_same_v<ColoniaT, ColoniaGrafo>) colonia.exportar_feromonios();
+            snapshots.enviar(lab, iteracao);
+        }
+        if (gravador) gravador->registrar(metricas);
 
-                case 3:
-                    arq_out << -3;
-                    break;
+        if (!resultado.melhorou_global) estagnacao++;
+        else estagnacao = 0;
 
-                default:
-                    arq_out << lab.get_feromonio(p);
-                    break;
+        if (estagnacao >= config.parada_por_estagnacao && config.parada_por_estagnacao != -1) {
+            std::cout << "PARADA POR ESTAGNACAO: " << estagnacao << " ITERACOES" << std::endl;
+            std::cout << "PARADA REALIZADA NA ITERACAO " << iteracao+1 << std::endl;
+            break;
+        }
+        if constexpr (TEM_CHECKPOINT) {
+            // já com o estado do fim desta iteração: quem retomar começa na próxima
+            if (checkpoints && (iteracao+1) % config.intervalo_checkpoint == 0) {
+                checkpoints->enviar(lab, colonia, {iteracao+1, estagnacao});
             }
-            if (j < lab.get_altura()-1) arq_out << ',';
         }
-        arq_out << '\n';
+        iteracao ++;
     }
 }
 
-int main () {
-    const auto start = std::chrono::high_resolution_clock::now();
-    try {
-        Labirinto lab(LARGURA_LAB, ALTURA_LAB, LABIRINTO_DIFICIL);
-        std::vector<Formiga> formigas;
-        formigas.reserve(N_FORMIGAS); // reserva o número necessário de espaço, é otimizado
-
-        for (int i=0; i<N_FORMIGAS; i++) {
-            // emplace_back funciona bem parecido com push_back, mas não recebe uma cópia, é mais otimizado
-            // para esse caso
-            formigas.emplace_back(lab, ALFA, BETA);
-        }
+// Modo ilhas: roda tudo de uma vez e mostra o melhor de cada ilha. O snapshot final é o feromônio da ilha que
+// achou o melhor caminho
+template<class ColoniaT>
+void executar_ilhas(const Labirinto& lab, const ConfigExecucao& config) {
+    Arquipelago<ColoniaT> arquipelago(lab, config.colonia, config.ilhas);
+    const ResultadoArquipelago resultado = arquipelago.executar(config.n_iteracoes);
 
-        std::vector<Pos> melhor_caminho_global;
-        int menor_tamanho_global = -1;
+    for (int i=0; i<config.ilhas.n_ilhas; i++) {
+        std::cout << "ILHA " << i << ": melhor caminho " << resultado.melhor_por_ilha[i] << '\n';
+    }
+    std::cout << "MELHOR GERAL: " << resultado.melhor_geral << " (ilha " << resultado.ilha_do_melhor << ", "
+              << resultado.iteracoes << " iteracoes)" << std::endl;
 
+    if (resultado.ilha_do_melhor != -1) {
 #ifdef _WIN32
         system("if not exist ..\\visualizacao mkdir ..\\visualizacao");
-        system("del /Q ..\\visualizacao\\*.csv 2>nul");
 #else
         system("mkdir -p ../visualizacao");
-        system("rm -f ../visualizacao/*.csv");
 #endif
+        const Labirinto& melhor = arquipelago.get_labirinto(resultado.ilha_do_melhor);
+        GravadorSnapshots snapshots("../visualizacao/snapshots.bin", melhor, config.nivel_snapshot,
+                                    config.regiao_snapshot);
+        snapshots.enviar(melhor, resultado.iteracoes);
+    }
+}
 
-        {
-        std::stringstream ss;
-        ss << "../visualizacao/iter_000.csv";
-        salvar_iteracao(lab, ss.str()); // salva a inicial antes das formigas andarem nele
-    } // fazer {} gera um bloco, como eu uso a variavel ss depois, deixei dentro do bloco pra não interferir
-
-        int iteracao = 0, estagnacao = 0;
-        bool atualizou = false;
-        while (iteracao<N_ITERACOES) { // a outra condição de parada é a estagnação, no final do loop da pra ver
-
-            #pragma omp parallel for // isso é basicamente um multithreading, dividindo o "loop" entre os nucleos
-            for (int i=0; i<N_FORMIGAS; i++) {
-                formigas[i].reset();
-
-                int passos_atuais = 0;
-                while (!formigas[i].encontrou_comida() && !formigas[i].falhou()) {
-                    formigas[i].mover();
-                    passos_atuais++;
-
-                    if (passos_atuais > MAX_PASSOS_TIMEOUT) formigas[i].falhar();
-                }
-            }
+// Uma execução normal (sem varredura) com a variante ColoniaT
+template<class ColoniaT>
+void executar_variante(Labirinto& lab, const ConfigExecucao& config) {
+    if (config.ilhas.n_ilhas > 1) {
+        executar_ilhas<ColoniaT>(lab, config);
+    }
+    else {
+        ColoniaT colonia(lab, config.colonia);
+        executar(colonia, lab, config);
+    }
+}
 
-            lab.evaporar_feromonios(TAXA_EVAPORACAO, MIN_FEROMONIO);
-            int menor_tamanho_iteracao = -1;
-            std::vector<Formiga*> formigas_com_sucesso;
-            formigas_com_sucesso.reserve(N_FORMIGAS);
-
-            for (Formiga& formiga : formigas) {
-                if (formiga.encontrou_comida()) {
-                    formigas_com_sucesso.push_back(&formiga);
-                    int tamanho_caminho = static_cast<int> (formiga.get_pilha_solucao().size());
-                    if (menor_tamanho_iteracao == -1 || tamanho_caminho < menor_tamanho_iteracao) {
-                        menor_tamanho_iteracao = tamanho_caminho;
-                    }
-                }
-            }
-            std::sort(formigas_com_sucesso.begin(), formigas_com_sucesso.end(), [](const Formiga * a, const Formiga * b) {
-                return a->get_pilha_solucao().size() < b->get_pilha_solucao().size();
-            });
-
-            int quantidade_deposito = std::min(static_cast<int>(formigas_com_sucesso.size()), ELITE);
-            for (int i=0; i<quantidade_deposito; i++) {
-                const std::vector<Pos>& caminho = formigas_com_sucesso[i]->get_pilha_solucao();
-                lab.depositar_feromonios(caminho, INTENSIDADE_FEROMONIO);
-
-                int tamanho = static_cast<int>(caminho.size());
-                if (menor_tamanho_global == -1 || tamanho < menor_tamanho_global) {
-                    menor_tamanho_global = tamanho;
-                    melhor_caminho_global = caminho;
-                    atualizou = true;
-                }
-            }
+int main (const int argc, char* argv[]) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    try {
+        const ParametrosExecucao parametros = ler_parametros(argc, argv);
+        if (parametros.ajuda) {
+            imprimir_ajuda(std::cout);
+            return 0;
+        }
+        GradeVarredura grade = montar_grade(parametros);
+        const ConfigExecucao& config = grade.configs.front(); // o labirinto e o processo são iguais em todas
+
+        Labirinto lab = config.arquivo_labirinto.empty() ? Labirinto(config.largura, config.altura, config.labirinto)
+                                                         : Labirinto(config.arquivo_labirinto);
+        if (!config.salvar_labirinto.empty()) lab.salvar(config.salvar_labirinto);
+        if (config.evaporacao_preguicosa) lab.set_modo_evaporacao(ModoEvaporacao::PREGUICOSA);
+        ajustar_ao_labirinto(grade, lab);
+
+#ifdef _OPENMP
+        if (config.threads > 0) omp_set_num_threads(config.threads);
+        std::cout << "THREADS OPENMP: " << omp_get_max_threads() << std::endl;
+#endif
 
-            if (!melhor_caminho_global.empty()) {
-                lab.depositar_feromonios(melhor_caminho_global, INTENSIDADE_FEROMONIO*ELITE*0.5);
-            }
+        if ((!config.checkpoint.empty() || !config.retomar.empty())
+            && (!grade.chaves.empty() || config.ilhas.n_ilhas > 1 || config.usar_grafo_juncoes)) {
+            throw std::runtime_error("checkpoint e retomar so valem na execucao normal "
+                                     "(sem varredura, ilhas ou grafo)");
+        }
 
-            std::cout << iteracao+1 << '/' << N_ITERACOES << std::endl;
-            if (menor_tamanho_iteracao == -1) {
-                std::cout << "Nenhuma solução encontrada." << std::endl;
-            }
-            else {
-                std::cout << "Melhor da iteracao: " << menor_tamanho_iteracao << std::endl;
-                std::cout << "Melhor caminho global: " << menor_tamanho_global << std::endl;
-                std::cout << "\n\n";
+        if (!grade.chaves.empty()) {
+            std::cout << "VARREDURA: " << grade.configs.size() << " configuracoes" << std::endl;
+#ifdef _WIN32
+            system("if not exist ..\\visualizacao mkdir ..\\visualizacao");
+#else
+            system("mkdir -p ../visualizacao");
+#endif
+            std::ofstream saida(config.saida_varredura);
+            if (!saida.is_open()) throw std::runtime_error("Nao foi possivel criar " + config.saida_varredura);
+            executar_varredura(lab, grade, saida);
+        }
+        else {
+            if (config.colonia.motor != MotorFormigas::ESCALAR) {
+                const bool simd = config.colonia.motor == MotorFormigas::LOTE && LoteFormigas::simd_disponivel();
+                std::cout << "MOTOR EM LOTE: " << LARGURA_LOTE << " formigas, " << (simd ? "AVX2" : "sem SIMD")
+                          << std::endl;
             }
 
-
-            if (((iteracao+1) % SALVAR_ITERACAO == 0 || (iteracao+1) == N_ITERACOES-1) && iteracao!=0) {
-                std::stringstream ss;
-                ss << "../visualizacao/iter_";
-                ss << std::setw(3) << std::setfill('0') << iteracao;
-                ss << ".csv";
-
-                salvar_iteracao(lab, ss.str());
+            if (config.usar_grafo_juncoes) { // sem ilhas e elitista, o montar_grade confere
+                ColoniaGrafo colonia(lab, config.colonia);
+                executar(colonia, lab, config);
             }
-
-            if (!atualizou) estagnacao++;
             else {
-                atualizou = false;
-                estagnacao = 0;
-            }
-            if (estagnacao >= PARADA_POR_ESTAGNACAO && PARADA_POR_ESTAGNACAO != -1) {
-                std::cout << "PARADA POR ESTAGNACAO: " << estagnacao << " ITERACOES" << std::endl;
-                std::cout << "PARADA REALIZADA NA ITERACAO " << iteracao+1 << std::endl;
-                break;
+                switch (config.variante) {
+                    case VarianteAco::ELITISTA: executar_variante<Colonia>(lab, config); break;
+                    case VarianteAco::MMAS: executar_variante<ColoniaMMAS>(lab, config); break;
+                    case VarianteAco::ACS: executar_variante<ColoniaACS>(lab, config); break;
+                    case VarianteAco::RANK: executar_variante<ColoniaRank>(lab, config); break;
+                }
             }
-            iteracao ++;
         }
         //lab.print_feromonios(); // funcionava pra debug, mas não é necessário e polui os prints finais
     } catch (const std::exception& e) {
@@ -188,4 +223,4 @@ int main () {
 
     std::cout << "Tempo de simulacao: " << std::fixed << std::setprecision(2) << duracao.count() << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -1,42 +1,66 @@
 import numpy as np
 import matplotlib.pyplot as plt
 import matplotlib.colors as mcolors
-import glob
 import sys
 import os
 
-PASTA_VISUALIZACAO = 'visualizacao' # nome da pasta com os arquivos csv q o c++ cria
+PASTA_VISUALIZACAO = 'visualizacao' # nome da pasta com os arquivos q o c++ cria
+ARQUIVO_SNAPSHOTS = os.path.join(PASTA_VISUALIZACAO, 'snapshots.bin')
 # VMIN deve ser igual ao 'MIN_FEROMONIO' definido no C++
 VMAX_FEROMONIO = 5.0
 VMIN_FEROMONIO = 0.01 
 
-def extrair_numero_iteracao(nome_arquivo): 
-    # Pega o número da iteração do arquivo em csv, se for (iter_050), extrai o numero 50
-    nome_base = os.path.basename(nome_arquivo)
-    iteracao = nome_base.split('_')[-1].split('.')[0]
-    return int(iteracao)
-
-def encontrar_arquivos(): # Pega todos os arquivos da pasta e ordena baseado no numero da iteracao
-    padrao_busca = os.path.join(PASTA_VISUALIZACAO, 'iter_*.csv')
-    arquivos = glob.glob(padrao_busca)
-    
-    if not arquivos:
-        print(f"Erro: Nenhum arquivo .csv encontrado em '{PASTA_VISUALIZACAO}'")
+# Tem que bater com o CabecalhoSnapshot do Visualizacao.h (64 bytes, little-endian)
+CABECALHO = np.dtype([
+    ('magico', 'S8'), ('versao', '<u4'), ('largura', '<u4'), ('altura', '<u4'), ('tipo_valor', '<u4'),
+    ('offset_quadros', '<u8'), ('tamanho_quadro', '<u8'),
+    ('ninho_x', '<i4'), ('ninho_y', '<i4'), ('comida_x', '<i4'), ('comida_y', '<i4'), ('reservado', 'u1', 8),
+])
+# Versão 2 (um nível da pirâmide, ExtensaoSnapshot): vem logo depois do cabeçalho
+EXTENSAO = np.dtype([('nivel', '<u4'), ('regiao_x', '<u4'), ('regiao_y', '<u4'), ('reservado', '<u4')])
+
+def abrir_snapshots():
+    # Lê o cabeçalho e mapeia o arquivo, sem carregar os quadros na memória.
+    # Retorna a camada fixa (grid), um memmap com os quadros (cada um tem 'iteracao' e 'feromonio', ou 'maximo' e
+    # 'media' na versão 2) e o nível (0 = células)
+    if not os.path.exists(ARQUIVO_SNAPSHOTS):
+        print(f"Erro: '{ARQUIVO_SNAPSHOTS}' não encontrado")
         print("Dica: Certifique-se de que o programa C++ foi executado e gerou os dados.")
         sys.exit() # Se der erro, mostra mensagem de erro e encerra o programa
 
-    # Ordena todos os arquivos por numero de iteracao
-    arquivos.sort(key=extrair_numero_iteracao)
-    iteracoes = [extrair_numero_iteracao(f) for f in arquivos]
-    
-    return arquivos, iteracoes # Retorna os arquivos e as iteracoes, arquivo iter_050.csv, iteracao 50
-
-def carregar_dados(arquivos):
-    frames = []
-    for f in arquivos:
-        # genfromtxt carrega o CSV em uma matriz numpy
-        frames.append(np.genfromtxt(f, delimiter=','))
-    return frames # retorna a lista com todas as matrizes
+    cabecalho = np.fromfile(ARQUIVO_SNAPSHOTS, dtype=CABECALHO, count=1)[0]
+    if cabecalho['magico'] != b'ACOSNAP' or cabecalho['versao'] not in (1, 2):
+        print(f"Erro: '{ARQUIVO_SNAPSHOTS}' não é um arquivo de snapshots conhecido")
+        sys.exit()
+
+    largura, altura = int(cabecalho['largura']), int(cabecalho['altura'])
+    offset = int(cabecalho['offset_quadros'])
+    inicio_grid = CABECALHO.itemsize
+    nivel = 0
+    campos = [('feromonio', '<f4', (largura, altura))]
+    if cabecalho['versao'] == 2:
+        extensao = np.fromfile(ARQUIVO_SNAPSHOTS, dtype=EXTENSAO, count=1, offset=CABECALHO.itemsize)[0]
+        inicio_grid += EXTENSAO.itemsize
+        nivel = int(extensao['nivel'])
+        campos = [('maximo', '<f4', (largura, altura)), ('media', '<f4', (largura, altura))]
+    grid = np.memmap(ARQUIVO_SNAPSHOTS, dtype=np.uint8, mode='r', offset=inicio_grid, shape=(largura, altura))
+
+    quadro = np.dtype([('iteracao', '<i4'), ('reservado', '<u4')] + campos)
+    # se o C++ ainda estiver rodando, o último quadro pode estar pela metade, então só conta os completos
+    n_quadros = (os.path.getsize(ARQUIVO_SNAPSHOTS) - offset) // quadro.itemsize
+    if n_quadros <= 0:
+        print(f"Erro: Nenhum snapshot em '{ARQUIVO_SNAPSHOTS}'")
+        sys.exit()
+    quadros = np.memmap(ARQUIVO_SNAPSHOTS, dtype=quadro, mode='r', offset=offset, shape=(n_quadros,))
+    return grid, quadros, nivel
+
+def montar_quadro(grid, feromonio):
+    # Mesmo formato que o CSV antigo tinha: paredes = -1, comida = -2, ninho = -3, o resto é feromônio
+    data = feromonio.astype(np.float64)
+    data[grid == 1] = -1
+    data[grid == 2] = -2
+    data[grid == 3] = -3
+    return data
 
 def configurar_cores():
     cores_mapa = { # Os numeros são negativos pois numeros positivos são feromonios
@@ -62,12 +86,17 @@ def configurar_cores():
 
 class InteractiveVisualizer:
     
-    def __init__(self, fig, ax, all_frames, all_iteracoes, cmaps):
+    def __init__(self, fig, ax, grid, quadros, nivel, cmaps):
         self.fig = fig
         self.ax = ax
         
-        self.frames = all_frames
-        self.iteracoes = all_iteracoes
+        # os quadros ficam no memmap, cada um só é lido do disco quando for desenhado
+        self.grid = grid
+        self.quadros = quadros
+        # na versão 2 cada bloco tem o máximo e a média, a tecla M troca entre os dois
+        self.nivel = nivel
+        self.campos = [c for c in ('feromonio', 'maximo', 'media') if c in quadros.dtype.names]
+        self.campo_atual = 0
         
         # Desempacota os mapas de cores recebidos
         self.cmap_lab, self.norm_lab, self.cmap_fero, self.norm_log = cmaps
@@ -81,7 +110,8 @@ class InteractiveVisualizer:
         self.draw_frame()
 
     def draw_frame(self):
-        data = self.frames[self.quadro_atual]
+        campo = self.campos[self.campo_atual]
+        data = montar_quadro(self.grid, self.quadros[self.quadro_atual][campo])
         
         # Reserva o labirinto, ignorando tudo que for maior ou igual a 0 (ignora caminhos/feromonios)
         lab_data = np.ma.masked_where(data >= 0, data)
@@ -102,8 +132,12 @@ class InteractiveVisualizer:
         
 
         # Configuração do titulo e visual basico
-        titulo = f"Iteração: {self.iteracoes[self.quadro_atual]}\n"
-        titulo += "[ESPAÇO/DIR]: Avançar | [ESQ]: Voltar"
+        titulo = f"Iteração: {self.quadros[self.quadro_atual]['iteracao']}"
+        if self.nivel > 0:
+            titulo += f" | blocos de {2**self.nivel}x{2**self.nivel} ({campo})"
+        titulo += "\n[ESPAÇO/DIR]: Avançar | [ESQ]: Voltar"
+        if len(self.campos) > 1:
+            titulo += " | [M]: Máximo/Média"
         
         self.ax.set_title(titulo)
         self.ax.set_aspect('equal')
@@ -114,10 +148,13 @@ class InteractiveVisualizer:
     def on_key_press(self, event): 
         # Função que implementa a logica para apertar o botão do teclado (se fosse gif ficaria ruim)
         if event.key == 'right' or event.key == ' ': # Se apertar tecla pra direita, avança X frames
-            self.quadro_atual = (self.quadro_atual + 1) % len(self.frames)
+            self.quadro_atual = (self.quadro_atual + 1) % len(self.quadros)
         
         elif event.key == 'left': # Se apertar tecla para esquerda, volta X frames
-            self.quadro_atual = (self.quadro_atual - 1) % len(self.frames)
+            self.quadro_atual = (self.quadro_atual - 1) % len(self.quadros)
+        
+        elif event.key == 'm' and len(self.campos) > 1: # Troca entre o máximo e a média dos blocos
+            self.campo_atual = (self.campo_atual + 1) % len(self.campos)
             
         else:
             return # Tecla não mapeada, não faz nada
@@ -126,15 +163,12 @@ class InteractiveVisualizer:
 
 
 def main():
-    arquivos, iteracoes = encontrar_arquivos() # Se não houverem arquivos, ele encerra o programa na função
-
-    # Carrega os dados e define as cores
-    frames_de_dados = carregar_dados(arquivos)
+    grid, quadros, nivel = abrir_snapshots() # Se não houver arquivo, ele encerra o programa na função
     cmaps = configurar_cores() 
 
 
     fig, ax = plt.subplots(figsize=(10, 10))
-    viz = InteractiveVisualizer(fig, ax, frames_de_dados, iteracoes, cmaps)
+    viz = InteractiveVisualizer(fig, ax, grid, quadros, nivel, cmaps)
     
     plt.show()
 